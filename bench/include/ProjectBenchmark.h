@@ -0,0 +1,122 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectBenchmark_H__
+#define __ProjectBenchmark_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+#include "ProjectImportExportPlugin.h"
+#include <ostream>
+
+namespace Ogre
+{
+	/** The plugin with the steps of the import made public, so the benchmark can time them separately */
+	class ProjectBenchmarkPlugin : public ProjectImportExportPlugin
+	{
+		public:
+			using ProjectImportExportPlugin::prepareImport;
+			using ProjectImportExportPlugin::getProjectPath;
+			using ProjectImportExportPlugin::copyFile;
+			using ProjectImportExportPlugin::validateZip;
+			using ProjectImportExportPlugin::readThumbNamesFromZip;
+			using ProjectImportExportPlugin::unzip;
+			using ProjectImportExportPlugin::createProjectFileForImport;
+			using ProjectImportExportPlugin::createMaterialCfgFileForImport;
+			using ProjectImportExportPlugin::createTextureCfgFileForImport;
+			using ProjectImportExportPlugin::createMeshesCfgFileForImport;
+	};
+
+	/** Headless benchmark of the plugin. It generates a synthetic project (materials, textures, thumbs and optional
+		meshes) in a work directory, runs the export, the phases of the import, the CRC-32 and hash table slide
+		implementations of zlib and a deflate stream of which the level changes a number of times and writes the results as Json. The plugin is built against stand-ins of Ogre and the HLMS Editor (see bench/standin).
+	*/
+	class ProjectBenchmark
+	{
+		public:
+			struct Settings
+			{
+				size_t numberOfMaterials;
+				size_t numberOfTextures;
+				size_t textureSize; // Bytes per texture
+				int textureEntropy; // Bits of entropy per byte (0 - 8)
+				size_t numberOfMeshes;
+				size_t meshSize; // Bytes per mesh
+				size_t repeat; // Number of times each phase is run
+				String workDirectory;
+
+				Settings (void);
+			};
+
+			ProjectBenchmark (const Settings& settings);
+			~ProjectBenchmark (void);
+
+			/** Create the synthetic project in the work directory */
+			bool generate (void);
+
+			/** Run all phases and write the results as Json; returns false if a phase fails */
+			bool run (std::ostream& out);
+
+			const String& getErrorText (void) const;
+
+		protected:
+			/** Timings of one phase; bytes is the amount of data the phase processes in one run */
+			struct Phase
+			{
+				String name;
+				uint64 bytes;
+				std::vector<double> seconds;
+			};
+
+			bool runExport (Phase& phase);
+			bool runImportPhases (size_t run, Phase& copy, Phase& validate, Phase& unzip, Phase& cfg);
+			bool runImport (size_t run, Phase& phase, bool mountArchive);
+			bool runCrc32 (Phase& phase, int variant, const String& content, unsigned long expectedCrc);
+			bool runSlideHash (Phase& phase, int variant, const std::vector<unsigned short>& table,
+				const std::vector<unsigned short>& expectedTable);
+			bool runDeflateLevelChange (Phase& phase, const String& content);
+			void writeFile (const String& fileName, const String& content);
+			void writeRandomFile (const String& fileName, size_t size, int entropy, const String& header);
+			String makeRandomContent (size_t size, int entropy, const String& header);
+			void writeResults (std::ostream& out, const std::vector<Phase>& phases);
+			bool setError (const String& errorText);
+
+			static double getTime (void);
+			static uint64 getPeakResidentSize (void);
+			static uint64 getFileSize (const String& fileName);
+			static bool makeDirectory (const String& path);
+
+		private:
+			Settings mSettings;
+			ProjectBenchmarkPlugin mPlugin;
+			HlmsEditorPluginData mExportData;
+			uint64 mProjectSize; // Total size of all files of the project
+			uint64 mRandom; // State of the random generator (xorshift)
+			String mErrorText;
+	};
+}
+
+#endif
@@ -0,0 +1,593 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectBenchmark.h"
+#include "OgreRoot.h"
+#include "OgreLogManager.h"
+#include "zlib.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <sstream>
+#include <iomanip>
+#include <sys/stat.h>
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#	include <windows.h>
+#	include <psapi.h>
+#	include <direct.h>
+#else
+#	include <sys/resource.h>
+#	include <unistd.h>
+#endif
+
+extern "C"
+{
+	// The implementations of crc32 in the vendored zlib (see zlib/crc32_simd.h)
+	int crc32_variant_available (int variant);
+	unsigned long crc32_variant (int variant, unsigned long crc, const unsigned char* buf, size_t len);
+
+	// The implementations of slide_hash in the vendored zlib (see zlib/deflate_simd.h)
+	int slide_hash_variant_available (int variant);
+	void slide_hash_variant (int variant, unsigned short* table, unsigned int entries, unsigned int wsize);
+}
+
+namespace Ogre
+{
+	static const String gProjectName = "benchmark";
+	static const String gZipName = gProjectName + ".hlmp.zip";
+	static const size_t gCrc32Size = 64 * 1024 * 1024;
+	static const char* gCrc32Variants[] = { "crc32_bytewise", "crc32_slice16", "crc32_pclmul" };
+	static const unsigned int gSlideHashWindowSize = 32768; // The head and prev tables of the default deflate settings
+	static const unsigned int gSlideHashEntries = 2 * gSlideHashWindowSize;
+	static const size_t gSlideHashSlides = 2048; // Slides per run
+	static const char* gSlideHashVariants[] = { "slide_hash_scalar", "slide_hash_sse2", "slide_hash_avx2", "slide_hash_neon" };
+	static const size_t gDeflateSize = 16 * 1024 * 1024;
+	static const size_t gDeflateChunkSize = 4093; // The level changes after each chunk; prime, so it changes at all positions in the window
+
+	//---------------------------------------------------------------------
+	ProjectBenchmark::Settings::Settings (void) :
+		numberOfMaterials(50),
+		numberOfTextures(100),
+		textureSize(1024 * 1024),
+		textureEntropy(6),
+		numberOfMeshes(0),
+		meshSize(1024 * 1024),
+		repeat(3),
+		workDirectory("benchmark_work")
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectBenchmark::ProjectBenchmark (const Settings& settings) :
+		mSettings(settings),
+		mProjectSize(0),
+		mRandom(0x9E3779B97F4A7C15ULL),
+		mErrorText("")
+	{
+		if (mSettings.repeat == 0)
+			mSettings.repeat = 1;
+		mSettings.textureEntropy = std::max(0, std::min(8, mSettings.textureEntropy));
+	}
+	//---------------------------------------------------------------------
+	ProjectBenchmark::~ProjectBenchmark (void)
+	{
+	}
+	//---------------------------------------------------------------------
+	bool ProjectBenchmark::generate (void)
+	{
+		// The plugin uses paths relative to the bin directory of the editor (../common/thumbs)
+		if (!makeDirectory(mSettings.workDirectory))
+			return setError("Cannot create " + mSettings.workDirectory);
+		makeDirectory(mSettings.workDirectory + "/bin");
+		makeDirectory(mSettings.workDirectory + "/common");
+		makeDirectory(mSettings.workDirectory + "/common/thumbs");
+		makeDirectory(mSettings.workDirectory + "/project");
+		makeDirectory(mSettings.workDirectory + "/export");
+		makeDirectory(mSettings.workDirectory + "/import");
+		String bin = mSettings.workDirectory + "/bin";
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+		if (_chdir(bin.c_str()) != 0)
+#else
+		if (chdir(bin.c_str()) != 0)
+#endif
+			return setError("Cannot change to " + bin);
+
+		mProjectSize = 0;
+		mExportData = HlmsEditorPluginData();
+		mExportData.mInProjectName = gProjectName;
+		mExportData.mInProjectPath = "../project/";
+		mExportData.mInExportPath = "../export/";
+		ResourceGroupManager::getSingleton().clear();
+		const Archive* archive = ResourceGroupManager::getSingleton().getArchive("../project");
+		char name[64];
+
+		// Textures; they are also available in the Ogre resources
+		std::ostringstream textureCfg;
+		textureCfg << "1\t0\t1\t1\tTextures\n";
+		String ddsHeader(128, '\0');
+		ddsHeader.replace(0, 4, "DDS ");
+		for (size_t i = 0; i < mSettings.numberOfTextures; ++i)
+		{
+			sprintf(name, "texture_%04u.dds", (unsigned int)i);
+			String fileName = String("../project/") + name;
+			writeRandomFile(fileName, mSettings.textureSize, mSettings.textureEntropy, ddsHeader);
+			mExportData.mInTextureFileNameVector.push_back(fileName);
+			ResourceGroupManager::getSingleton().addFileInfo(archive, name, mSettings.textureSize);
+			textureCfg << "1\t1\t" << (i + 2) << "\t3\t" << fileName << "\n";
+		}
+		mExportData.mInTextureFileName = "../project/" + gProjectName + "_textures.cfg";
+		writeFile(mExportData.mInTextureFileName, textureCfg.str());
+
+		// Materials, each with a diffuse and a normal map, and their thumbs
+		std::ostringstream materialCfg;
+		materialCfg << "1\t0\t1\t1\tMaterials\n";
+		String pngHeader("\x89PNG\r\n\x1a\n", 8);
+		for (size_t i = 0; i < mSettings.numberOfMaterials; ++i)
+		{
+			std::ostringstream json;
+			sprintf(name, "material_%04u", (unsigned int)i);
+			json << "{\n\t\"pbs\" :\n\t{\n\t\t\"" << name << "\" :\n\t\t{\n"
+				<< "\t\t\t\"workflow\" : \"specular_ogre\",\n";
+			if (mSettings.numberOfTextures > 0)
+			{
+				char diffuse[64];
+				char normal[64];
+				sprintf(diffuse, "texture_%04u.dds", (unsigned int)((2 * i) % mSettings.numberOfTextures));
+				sprintf(normal, "texture_%04u.dds", (unsigned int)((2 * i + 1) % mSettings.numberOfTextures));
+				json << "\t\t\t\"diffuse\" : { \"value\" : [1, 1, 1], \"texture\" : \"" << diffuse << "\" },\n"
+					<< "\t\t\t\"normal\" : { \"value\" : 1, \"texture\" : \"" << normal << "\" },\n";
+				mExportData.mInTexturesUsedByDatablocks.push_back(diffuse);
+				mExportData.mInTexturesUsedByDatablocks.push_back(normal);
+			}
+			json << "\t\t\t\"roughness\" : { \"value\" : 0.5 }\n\t\t}\n\t}\n}\n";
+
+			String baseName = String(name) + ".material.json";
+			String fileName = "../project/" + baseName;
+			writeFile(fileName, json.str());
+			writeRandomFile("../common/thumbs/" + baseName + ".png", 4096, 8, pngHeader);
+			mExportData.mInMaterialFileNameVector.push_back(fileName);
+			materialCfg << "1\t1\t" << (i + 2) << "\t3\t" << baseName << "\t" << fileName << "\n"; // Like the editor: name and path
+		}
+		mExportData.mInMaterialFileName = "../project/" + gProjectName + "_materials.cfg";
+		writeFile(mExportData.mInMaterialFileName, materialCfg.str());
+
+		// Optional meshes
+		for (size_t i = 0; i < mSettings.numberOfMeshes; ++i)
+		{
+			sprintf(name, "mesh_%04u.mesh", (unsigned int)i);
+			String fileName = String("../project/") + name;
+			writeRandomFile(fileName, mSettings.meshSize, 7, "");
+			mExportData.mInMeshFileNames.push_back(fileName);
+		}
+		mExportData.mInMeshesFileName = "../project/" + gProjectName + "_meshes.cfg";
+
+		mExportData.mInPropertiesMap = mPlugin.getProperties();
+		mExportData.mInPropertiesMap["include_meshes"].boolValue = mSettings.numberOfMeshes > 0;
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectBenchmark::run (std::ostream& out)
+	{
+		std::vector<Phase> phases(8);
+		phases[0].name = "export";
+		phases[1].name = "export_incremental";
+		phases[2].name = "staging_copy";
+		phases[3].name = "validate_zip";
+		phases[4].name = "unzip";
+		phases[5].name = "cfg_rewrite";
+		phases[6].name = "import";
+		phases[7].name = "import_mounted";
+
+		for (size_t run = 0; run < mSettings.repeat; ++run)
+		{
+			// A full export, followed by an export in which nothing changed
+			std::remove(("../export/" + gZipName).c_str());
+			if (!runExport(phases[0]) || !runExport(phases[1]))
+				return false;
+
+			if (!runImportPhases(run, phases[2], phases[3], phases[4], phases[5]))
+				return false;
+			if (!runImport(run, phases[6], false) || !runImport(run, phases[7], true))
+				return false;
+		}
+
+		// The CRC-32 of every exported and imported byte is calculated; each implementation that the cpu supports
+		String content = makeRandomContent(gCrc32Size, 8, "");
+		unsigned long expectedCrc = crc32_variant(0, 0, (const unsigned char*)content.data(), content.size());
+		for (int variant = 0; variant < (int)(sizeof(gCrc32Variants) / sizeof(gCrc32Variants[0])); ++variant)
+		{
+			if (!crc32_variant_available(variant))
+				continue;
+
+			Phase phase;
+			phase.name = gCrc32Variants[variant];
+			for (size_t run = 0; run < mSettings.repeat; ++run)
+			{
+				if (!runCrc32(phase, variant, content, expectedCrc))
+					return false;
+			}
+			phases.push_back(phase);
+		}
+
+		// Deflate slides its hash tables each time the window moves (every 32K of input); each implementation
+		String tableContent = makeRandomContent(gSlideHashEntries * sizeof(unsigned short), 8, "");
+		std::vector<unsigned short> table(gSlideHashEntries);
+		memcpy(&table[0], tableContent.data(), tableContent.size());
+		std::vector<unsigned short> expectedTable(table);
+		slide_hash_variant(0, &expectedTable[0], gSlideHashEntries, gSlideHashWindowSize);
+		for (int variant = 0; variant < (int)(sizeof(gSlideHashVariants) / sizeof(gSlideHashVariants[0])); ++variant)
+		{
+			if (!slide_hash_variant_available(variant))
+				continue;
+
+			Phase phase;
+			phase.name = gSlideHashVariants[variant];
+			for (size_t run = 0; run < mSettings.repeat; ++run)
+			{
+				if (!runSlideHash(phase, variant, table, expectedTable))
+					return false;
+			}
+			phases.push_back(phase);
+		}
+
+		// The level of a deflate stream changes in the middle of the stream (deflateParams), which switches between the
+		// match finders of deflate_fast and deflate_slow; the output must still inflate to the input
+		String deflateContent = makeRandomContent(gDeflateSize, 3, "");
+		Phase deflatePhase;
+		deflatePhase.name = "deflate_level_change";
+		for (size_t run = 0; run < mSettings.repeat; ++run)
+		{
+			if (!runDeflateLevelChange(deflatePhase, deflateContent))
+				return false;
+		}
+		phases.push_back(deflatePhase);
+
+		writeResults(out, phases);
+		return true;
+	}
+	//---------------------------------------------------------------------
+	const String& ProjectBenchmark::getErrorText (void) const
+	{
+		return mErrorText;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectBenchmark::runExport (Phase& phase)
+	{
+		HlmsEditorPluginData data = mExportData;
+		double start = getTime();
+		bool result = mPlugin.executeExport(&data);
+		phase.seconds.push_back(getTime() - start);
+		phase.bytes = mProjectSize;
+		if (!result)
+			return setError("Export failed: " + data.mOutErrorText);
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectBenchmark::runCrc32 (Phase& phase, int variant, const String& content, unsigned long expectedCrc)
+	{
+		double start = getTime();
+		unsigned long crc = crc32_variant(variant, 0, (const unsigned char*)content.data(), content.size());
+		phase.seconds.push_back(getTime() - start);
+		phase.bytes = content.size();
+		if (crc != expectedCrc)
+			return setError("Wrong CRC-32 calculated by " + phase.name);
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectBenchmark::runSlideHash (Phase& phase, int variant, const std::vector<unsigned short>& table,
+		const std::vector<unsigned short>& expectedTable)
+	{
+		// Every slide starts from the same table, which is copied outside of the timing
+		std::vector<unsigned short> slid(table.size());
+		double seconds = 0.0;
+		for (size_t i = 0; i < gSlideHashSlides; ++i)
+		{
+			memcpy(&slid[0], &table[0], table.size() * sizeof(unsigned short));
+			double start = getTime();
+			slide_hash_variant(variant, &slid[0], (unsigned int)slid.size(), gSlideHashWindowSize);
+			seconds += getTime() - start;
+			if (i == 0 && slid != expectedTable)
+				return setError("Wrong table slid by " + phase.name);
+		}
+		phase.seconds.push_back(seconds);
+		phase.bytes = gSlideHashSlides * table.size() * sizeof(unsigned short);
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectBenchmark::runDeflateLevelChange (Phase& phase, const String& content)
+	{
+		// Each change of the level ends the current block, so the output may exceed the bound of a single call
+		size_t chunks = content.size() / gDeflateChunkSize + 1;
+		std::vector<unsigned char> compressed(compressBound((uLong)content.size()) + chunks * 64);
+		z_stream stream;
+		memset(&stream, 0, sizeof(z_stream));
+		if (deflateInit(&stream, 1) != Z_OK)
+			return setError("Error initialising compression of " + phase.name);
+
+		double start = getTime();
+		stream.next_out = &compressed[0];
+		stream.avail_out = (uInt)compressed.size();
+		int err = Z_OK;
+		for (size_t offset = 0, chunk = 0; offset < content.size() && err == Z_OK; offset += gDeflateChunkSize, ++chunk)
+		{
+			if (chunk > 0)
+				err = deflateParams(&stream, chunk % 2 ? 6 : 1, Z_DEFAULT_STRATEGY);
+			size_t length = std::min(gDeflateChunkSize, content.size() - offset);
+			stream.next_in = (Bytef*)content.data() + offset;
+			stream.avail_in = (uInt)length;
+			if (err == Z_OK)
+				err = deflate(&stream, offset + length == content.size() ? Z_FINISH : Z_NO_FLUSH);
+		}
+		phase.seconds.push_back(getTime() - start);
+		phase.bytes = content.size();
+		uLong compressedSize = stream.total_out;
+		deflateEnd(&stream);
+		if (err != Z_STREAM_END)
+			return setError("Compression failed in " + phase.name);
+
+		std::vector<unsigned char> inflated(content.size());
+		uLongf inflatedSize = (uLongf)inflated.size();
+		if (uncompress(&inflated[0], &inflatedSize, &compressed[0], compressedSize) != Z_OK ||
+			inflatedSize != content.size() || memcmp(&inflated[0], content.data(), content.size()) != 0)
+			return setError("Wrong data compressed by " + phase.name);
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectBenchmark::runImportPhases (size_t run, Phase& copy, Phase& validate, Phase& unzip, Phase& cfg)
+	{
+		// The same steps as ProjectImportExportPlugin::importProject, each timed separately
+		std::ostringstream baseName;
+		baseName << gProjectName << "_phases_" << run;
+		HlmsEditorPluginData data;
+		data.mInFileDialogName = gZipName;
+		data.mInFileDialogBaseName = baseName.str();
+		data.mInExportPath = "../export/";
+		data.mInImportPath = "../import/";
+		mPlugin.prepareImport(&data);
+		makeDirectory(mPlugin.getProjectPath());
+
+		// The staging copy is optional (import_staging_copy); it is timed, but the zip file is extracted in place
+		String sourceZip = data.mInExportPath + data.mInFileDialogName;
+		String destinationZip = mPlugin.getProjectPath() + gZipName;
+		double start = getTime();
+		bool result = mPlugin.copyFile(sourceZip, destinationZip);
+		copy.seconds.push_back(getTime() - start);
+		copy.bytes = getFileSize(sourceZip);
+		std::remove(destinationZip.c_str());
+		if (!result)
+			return setError("Copying " + sourceZip + " failed");
+
+		// Reading the central directory is part of the validation, which reports the uncompressed size of all
+		// entries to the progress
+		ProjectZipReader zipReader;
+		uint64 bytesTotal = mPlugin.getJobProgress().getBytesTotal();
+		start = getTime();
+		result = zipReader.open(sourceZip) && mPlugin.validateZip(zipReader, &data);
+		validate.seconds.push_back(getTime() - start);
+		validate.bytes = copy.bytes;
+		if (!result)
+			return setError("Validation failed: " + data.mOutErrorText);
+
+		start = getTime();
+		ProjectNameIndex thumbNames;
+		result = mPlugin.readThumbNamesFromZip(zipReader, &thumbNames) && mPlugin.unzip(zipReader, &data, NULL, &thumbNames);
+		unzip.seconds.push_back(getTime() - start);
+		unzip.bytes = mPlugin.getJobProgress().getBytesTotal() - bytesTotal;
+		if (!result)
+			return setError("Unzip failed: " + data.mOutErrorText);
+
+		// The cfg files are not extracted, but rewritten from the zip file in memory
+		start = getTime();
+		result = mPlugin.createProjectFileForImport(zipReader, &data) &&
+			mPlugin.createMaterialCfgFileForImport(zipReader, &data) &&
+			mPlugin.createTextureCfgFileForImport(zipReader, &data);
+		if (result)
+			mPlugin.createMeshesCfgFileForImport(zipReader, &data);
+		cfg.seconds.push_back(getTime() - start);
+
+		// The bytes of the phase are the cfg files it reads from the zip file (meshes.cfg is optional)
+		static const char* cfgNames[] = { "project.txt", "materials.cfg", "textures.cfg", "meshes.cfg" };
+		cfg.bytes = 0;
+		for (size_t i = 0; i < sizeof(cfgNames) / sizeof(cfgNames[0]); ++i)
+		{
+			const ImportEntry* entry = zipReader.findEntry(cfgNames[i]);
+			if (entry)
+				cfg.bytes += entry->uncompressedSize;
+		}
+		zipReader.close();
+		if (!result)
+			return setError("Rewriting the cfg files failed");
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectBenchmark::runImport (size_t run, Phase& phase, bool mountArchive)
+	{
+		std::ostringstream baseName;
+		baseName << gProjectName << (mountArchive ? "_mounted_" : "_") << run;
+		HlmsEditorPluginData data;
+		data.mInFileDialogName = gZipName;
+		data.mInFileDialogBaseName = baseName.str();
+		data.mInExportPath = "../export/";
+		data.mInImportPath = "../import/";
+
+		// With import_mount_archive the textures stay in the zip file
+		data.mInPropertiesMap = mPlugin.getProperties();
+		data.mInPropertiesMap["import_mount_archive"].boolValue = mountArchive;
+
+		// The editor creates the directory (PAF_PRE_IMPORT_MK_DIR)
+		makeDirectory(data.mInImportPath + data.mInFileDialogBaseName);
+		double start = getTime();
+		bool result = mPlugin.executeImport(&data);
+		phase.seconds.push_back(getTime() - start);
+		phase.bytes = getFileSize(data.mInExportPath + gZipName);
+		if (!result)
+			return setError("Import failed: " + data.mOutErrorText);
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	void ProjectBenchmark::writeFile (const String& fileName, const String& content)
+	{
+		FILE* out = fopen(fileName.c_str(), "wb");
+		if (out == NULL)
+			return;
+		fwrite(content.data(), 1, content.size(), out);
+		fclose(out);
+		mProjectSize += content.size();
+	}
+	//---------------------------------------------------------------------
+	void ProjectBenchmark::writeRandomFile (const String& fileName, size_t size, int entropy, const String& header)
+	{
+		writeFile(fileName, makeRandomContent(size, entropy, header));
+	}
+	//---------------------------------------------------------------------
+	String ProjectBenchmark::makeRandomContent (size_t size, int entropy, const String& header)
+	{
+		// Each byte has 'entropy' random bits; 0 gives content of zeros, 8 incompressible content
+		String content(header.substr(0, size));
+		content.reserve(size);
+		unsigned char mask = (unsigned char)((1 << entropy) - 1);
+		while (content.size() < size)
+		{
+			// xorshift64
+			mRandom ^= mRandom << 13;
+			mRandom ^= mRandom >> 7;
+			mRandom ^= mRandom << 17;
+			uint64 bits = mRandom;
+			for (int i = 0; i < 8 && content.size() < size; ++i, bits >>= 8)
+				content.push_back((char)(bits & mask));
+		}
+
+		return content;
+	}
+	//---------------------------------------------------------------------
+	void ProjectBenchmark::writeResults (std::ostream& out, const std::vector<Phase>& phases)
+	{
+		out << std::fixed << std::setprecision(6);
+		out << "{\n";
+		out << "\t\"settings\" : {\n"
+			<< "\t\t\"materials\" : " << mSettings.numberOfMaterials << ",\n"
+			<< "\t\t\"textures\" : " << mSettings.numberOfTextures << ",\n"
+			<< "\t\t\"texture_size\" : " << mSettings.textureSize << ",\n"
+			<< "\t\t\"texture_entropy\" : " << mSettings.textureEntropy << ",\n"
+			<< "\t\t\"meshes\" : " << mSettings.numberOfMeshes << ",\n"
+			<< "\t\t\"mesh_size\" : " << mSettings.meshSize << ",\n"
+			<< "\t\t\"repeat\" : " << mSettings.repeat << "\n"
+			<< "\t},\n";
+		out << "\t\"project_bytes\" : " << mProjectSize << ",\n";
+		out << "\t\"zip_bytes\" : " << getFileSize("../export/" + gZipName) << ",\n";
+		out << "\t\"phases\" : [\n";
+		for (size_t i = 0; i < phases.size(); ++i)
+		{
+			const Phase& phase = phases[i];
+			double minimum = phase.seconds.empty() ? 0.0 : phase.seconds[0];
+			double maximum = minimum;
+			double total = 0.0;
+			for (size_t run = 0; run < phase.seconds.size(); ++run)
+			{
+				minimum = std::min(minimum, phase.seconds[run]);
+				maximum = std::max(maximum, phase.seconds[run]);
+				total += phase.seconds[run];
+			}
+			double mean = phase.seconds.empty() ? 0.0 : total / phase.seconds.size();
+
+			out << "\t\t{ \"name\" : \"" << phase.name << "\", \"runs\" : " << phase.seconds.size()
+				<< ", \"bytes\" : " << phase.bytes
+				<< ", \"seconds_min\" : " << minimum
+				<< ", \"seconds_mean\" : " << mean
+				<< ", \"seconds_max\" : " << maximum
+				<< ", \"throughput_mb_per_s\" : ";
+			if (phase.bytes > 0 && mean > 0.0)
+				out << (phase.bytes / mean) / 1000000.0;
+			else
+				out << "null";
+			out << " }" << (i + 1 < phases.size() ? "," : "") << "\n";
+		}
+		out << "\t],\n";
+		out << "\t\"peak_rss_bytes\" : " << getPeakResidentSize() << "\n";
+		out << "}\n";
+	}
+	//---------------------------------------------------------------------
+	bool ProjectBenchmark::setError (const String& errorText)
+	{
+		mErrorText = errorText;
+		return false;
+	}
+	//---------------------------------------------------------------------
+	double ProjectBenchmark::getTime (void)
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	//---------------------------------------------------------------------
+	uint64 ProjectBenchmark::getPeakResidentSize (void)
+	{
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+			return 0;
+		return (uint64)counters.PeakWorkingSetSize;
+#else
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return 0;
+#	if OGRE_PLATFORM == OGRE_PLATFORM_APPLE
+		return (uint64)usage.ru_maxrss; // Bytes
+#	else
+		return (uint64)usage.ru_maxrss * 1024; // Kilobytes
+#	endif
+#endif
+	}
+	//---------------------------------------------------------------------
+	uint64 ProjectBenchmark::getFileSize (const String& fileName)
+	{
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+		struct _stat64 st;
+		if (_stat64(fileName.c_str(), &st) != 0)
+			return 0;
+#else
+		struct stat st;
+		if (stat(fileName.c_str(), &st) != 0)
+			return 0;
+#endif
+		return (uint64)st.st_size;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectBenchmark::makeDirectory (const String& path)
+	{
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+		return _mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+		return mkdir(path.c_str(), 0777) == 0 || errno == EEXIST;
+#endif
+	}
+}
@@ -0,0 +1,120 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectBenchmark.h"
+#include "OgreLogManager.h"
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+
+using namespace Ogre;
+
+//---------------------------------------------------------------------
+static void printUsage (void)
+{
+	std::cerr << "Usage: ProjectImportExportBenchmark [options]\n"
+		"  --materials <n>       Number of material files (default 50)\n"
+		"  --textures <n>        Number of textures (default 100)\n"
+		"  --texture-size <n>    Bytes per texture (default 1048576)\n"
+		"  --entropy <bits>      Random bits per texture byte, 0 - 8 (default 6)\n"
+		"  --meshes <n>          Number of meshes (default 0)\n"
+		"  --mesh-size <n>       Bytes per mesh (default 1048576)\n"
+		"  --repeat <n>          Number of runs of each phase (default 3)\n"
+		"  --work <dir>          Work directory (default benchmark_work)\n"
+		"  --output <file>       Write the Json results to a file instead of stdout\n"
+		"  --verbose             Show the log of the plugin on stderr\n";
+}
+//---------------------------------------------------------------------
+int main (int argc, char** argv)
+{
+	ProjectBenchmark::Settings settings;
+	String output;
+	bool verbose = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		String arg = argv[i];
+		if (arg == "--verbose")
+		{
+			verbose = true;
+			continue;
+		}
+		if (i + 1 >= argc)
+		{
+			printUsage();
+			return 1;
+		}
+
+		String value = argv[++i];
+		if (arg == "--materials")
+			settings.numberOfMaterials = (size_t)strtoull(value.c_str(), NULL, 10);
+		else if (arg == "--textures")
+			settings.numberOfTextures = (size_t)strtoull(value.c_str(), NULL, 10);
+		else if (arg == "--texture-size")
+			settings.textureSize = (size_t)strtoull(value.c_str(), NULL, 10);
+		else if (arg == "--entropy")
+			settings.textureEntropy = atoi(value.c_str());
+		else if (arg == "--meshes")
+			settings.numberOfMeshes = (size_t)strtoull(value.c_str(), NULL, 10);
+		else if (arg == "--mesh-size")
+			settings.meshSize = (size_t)strtoull(value.c_str(), NULL, 10);
+		else if (arg == "--repeat")
+			settings.repeat = (size_t)strtoull(value.c_str(), NULL, 10);
+		else if (arg == "--work")
+			settings.workDirectory = value;
+		else if (arg == "--output")
+			output = value;
+		else
+		{
+			printUsage();
+			return 1;
+		}
+	}
+
+	LogManager::getSingleton().setQuiet(!verbose);
+
+	// The output file is opened before the benchmark changes the working directory
+	std::ofstream outFile;
+	if (!output.empty())
+	{
+		outFile.open(output.c_str());
+		if (!outFile)
+		{
+			std::cerr << "Cannot create " << output << std::endl;
+			return 1;
+		}
+	}
+
+	ProjectBenchmark benchmark(settings);
+	if (!benchmark.generate() || !benchmark.run(output.empty() ? std::cout : outFile))
+	{
+		std::cerr << benchmark.getErrorText() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,56 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only.
+*/
+#ifndef __OgreArchive_H__
+#define __OgreArchive_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreDataStream.h"
+
+namespace Ogre
+{
+	struct FileInfo;
+	typedef std::vector<FileInfo> FileInfoList;
+	typedef SharedPtr<FileInfoList> FileInfoListPtr;
+
+	/** The stand-in is not abstract; the resource group manager creates plain archives to refer to */
+	class Archive
+	{
+		public:
+			Archive (const String& name, const String& archType) : mName(name), mType(archType), mReadOnly(true) {}
+			virtual ~Archive (void) {}
+			const String& getName (void) const { return mName; }
+			const String& getType (void) const { return mType; }
+
+			virtual bool isCaseSensitive (void) const { return true; }
+			virtual void load (void) {}
+			virtual void unload (void) {}
+			virtual DataStreamPtr open (const String& filename, bool readOnly = true) const { return DataStreamPtr(); }
+			virtual StringVectorPtr list (bool recursive = true, bool dirs = false) { return StringVectorPtr(new StringVector()); }
+			virtual FileInfoListPtr listFileInfo (bool recursive = true, bool dirs = false);
+			virtual StringVectorPtr find (const String& pattern, bool recursive = true, bool dirs = false) { return StringVectorPtr(new StringVector()); }
+			virtual FileInfoListPtr findFileInfo (const String& pattern, bool recursive = true, bool dirs = false) const;
+			virtual bool exists (const String& filename) { return false; }
+			virtual time_t getModifiedTime (const String& filename) { return 0; }
+
+		protected:
+			String mName;
+			String mType;
+			bool mReadOnly;
+	};
+
+	struct FileInfo
+	{
+		const Archive* archive;
+		String filename;
+		String path;
+		String basename;
+		size_t compressedSize;
+		size_t uncompressedSize;
+	};
+
+	inline FileInfoListPtr Archive::listFileInfo (bool recursive, bool dirs) { return FileInfoListPtr(new FileInfoList()); }
+	inline FileInfoListPtr Archive::findFileInfo (const String& pattern, bool recursive, bool dirs) const { return FileInfoListPtr(new FileInfoList()); }
+}
+
+#endif
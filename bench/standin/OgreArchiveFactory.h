@@ -0,0 +1,29 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only.
+*/
+#ifndef __OgreArchiveFactory_H__
+#define __OgreArchiveFactory_H__
+
+#include "OgreArchive.h"
+
+namespace Ogre
+{
+	template <typename T> class FactoryObj
+	{
+		public:
+			virtual ~FactoryObj (void) {}
+			virtual const String& getType (void) const = 0;
+			virtual T* createInstance (const String& name) = 0;
+			virtual void destroyInstance (T* ptr) = 0;
+	};
+
+	class ArchiveFactory : public FactoryObj<Archive>
+	{
+		public:
+			virtual ~ArchiveFactory (void) {}
+			virtual Archive* createInstance (const String& name, bool readOnly) = 0;
+			virtual Archive* createInstance (const String& name) { return createInstance(name, true); }
+	};
+}
+
+#endif
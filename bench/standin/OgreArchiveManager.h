@@ -0,0 +1,26 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only. The factories are only remembered.
+*/
+#ifndef __OgreArchiveManager_H__
+#define __OgreArchiveManager_H__
+
+#include "OgreArchiveFactory.h"
+
+namespace Ogre
+{
+	class ArchiveManager
+	{
+		public:
+			static ArchiveManager& getSingleton (void);
+
+			void addArchiveFactory (ArchiveFactory* factory);
+
+			/** Stand-in only: returns the factory of an archive type, or 0 */
+			ArchiveFactory* getArchiveFactory (const String& archiveType);
+
+		private:
+			std::map<String, ArchiveFactory*> mFactories;
+	};
+}
+
+#endif
@@ -0,0 +1,51 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only. Only the memory stream is created by the plugin.
+*/
+#ifndef __OgreDataStream_H__
+#define __OgreDataStream_H__
+
+#include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+	class DataStream
+	{
+		public:
+			DataStream (const String& name) : mName(name), mSize(0) {}
+			virtual ~DataStream (void) {}
+			const String& getName (void) const { return mName; }
+			size_t size (void) const { return mSize; }
+			virtual size_t read (void* buf, size_t count) { return 0; }
+			virtual bool eof (void) const { return true; }
+
+		protected:
+			String mName;
+			size_t mSize;
+	};
+
+	typedef SharedPtr<DataStream> DataStreamPtr;
+
+	class MemoryDataStream : public DataStream
+	{
+		public:
+			MemoryDataStream (const String& name, size_t size, bool freeOnClose = true, bool readOnly = false) :
+				DataStream(name), mData(size), mPos(0) { mSize = size; }
+			uchar* getPtr (void) { return mData.empty() ? 0 : &mData[0]; }
+
+			size_t read (void* buf, size_t count)
+			{
+				count = std::min(count, mData.size() - mPos);
+				if (count > 0)
+					memcpy(buf, &mData[mPos], count);
+				mPos += count;
+				return count;
+			}
+			bool eof (void) const { return mPos >= mData.size(); }
+
+		private:
+			std::vector<uchar> mData;
+			size_t mPos;
+	};
+}
+
+#endif
@@ -0,0 +1,9 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only. The plugin includes this header, but does not use it.
+*/
+#ifndef __OgreHlmsUnlit_H__
+#define __OgreHlmsUnlit_H__
+
+#include "OgrePrerequisites.h"
+
+#endif
@@ -0,0 +1,9 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only. The plugin includes this header, but does not use it.
+*/
+#ifndef __OgreHlmsUnlitDatablock_H__
+#define __OgreHlmsUnlitDatablock_H__
+
+#include "OgrePrerequisites.h"
+
+#endif
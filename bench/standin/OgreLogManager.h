@@ -0,0 +1,30 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only. Messages go to stderr, so they do not mix with
+  the results on stdout; they can be switched off.
+*/
+#ifndef __OgreLogManager_H__
+#define __OgreLogManager_H__
+
+#include "OgrePrerequisites.h"
+#include <mutex>
+
+namespace Ogre
+{
+	class LogManager
+	{
+		public:
+			static LogManager& getSingleton (void);
+
+			void logMessage (const String& message);
+
+			/** Stand-in only */
+			void setQuiet (bool quiet) { mQuiet = quiet; }
+
+		private:
+			LogManager (void) : mQuiet(false) {}
+			bool mQuiet;
+			std::mutex mMutex;
+	};
+}
+
+#endif
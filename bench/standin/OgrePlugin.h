@@ -0,0 +1,24 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only.
+*/
+#ifndef __OgrePlugin_H__
+#define __OgrePlugin_H__
+
+#include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+	class Plugin
+	{
+		public:
+			Plugin (void) {}
+			virtual ~Plugin (void) {}
+			virtual const String& getName (void) const = 0;
+			virtual void install (void) = 0;
+			virtual void initialise (void) = 0;
+			virtual void shutdown (void) = 0;
+			virtual void uninstall (void) = 0;
+	};
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only. It provides the small part of Ogre that the plugin
+  uses, so the plugin can be built and measured without Ogre and the HLMS Editor.
+*/
+#ifndef __OgrePrerequisites_H__
+#define __OgrePrerequisites_H__
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <ctime>
+
+#define OGRE_PLATFORM_WIN32 1
+#define OGRE_PLATFORM_LINUX 2
+#define OGRE_PLATFORM_APPLE 3
+#define OGRE_PLATFORM_WINRT 4
+#if defined(_WIN32)
+#	define OGRE_PLATFORM OGRE_PLATFORM_WIN32
+#elif defined(__APPLE__)
+#	define OGRE_PLATFORM OGRE_PLATFORM_APPLE
+#else
+#	define OGRE_PLATFORM OGRE_PLATFORM_LINUX
+#endif
+
+#define OGRE_STATIC_LIB
+#define OGRE_NEW new
+#define OGRE_DELETE delete
+#define OGRE_NEW_T(T, category) new T
+
+namespace Ogre
+{
+	typedef std::string String;
+	typedef unsigned long long uint64;
+	typedef unsigned int uint32;
+	typedef unsigned char uchar;
+	typedef std::vector<String> StringVector;
+
+	enum MemoryCategory { MEMCATEGORY_GENERAL };
+	enum SharedPtrFreeMethod { SPFM_DELETE, SPFM_DELETE_T, SPFM_FREE };
+
+	/** Ogre's shared pointer; the free method is not needed, because OGRE_NEW_T is plain new */
+	template <typename T> class SharedPtr : public std::shared_ptr<T>
+	{
+		public:
+			SharedPtr (T* ptr = 0, SharedPtrFreeMethod freeMethod = SPFM_DELETE) : std::shared_ptr<T>(ptr) {}
+			bool isNull (void) const { return !this->get(); }
+	};
+
+	typedef SharedPtr<StringVector> StringVectorPtr;
+
+	class Archive;
+	class Root;
+
+	class StringUtil
+	{
+		public:
+			static void toLowerCase (String& str)
+			{
+				std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+			}
+
+			static void toUpperCase (String& str)
+			{
+				std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+			}
+
+			/** Only exact (case sensitive) matches; the plugin does not use wildcards */
+			static bool match (const String& str, const String& pattern, bool caseSensitive = true)
+			{
+				if (caseSensitive)
+					return str == pattern;
+
+				String lowerStr = str;
+				String lowerPattern = pattern;
+				toLowerCase(lowerStr);
+				toLowerCase(lowerPattern);
+				return lowerStr == lowerPattern;
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,36 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only. The resources are registered by the benchmark
+  with addFileInfo(), instead of being found in resource locations.
+*/
+#ifndef __OgreResourceGroupManager_H__
+#define __OgreResourceGroupManager_H__
+
+#include "OgreArchive.h"
+
+namespace Ogre
+{
+	class ResourceGroupManager
+	{
+		public:
+			static String DEFAULT_RESOURCE_GROUP_NAME;
+
+			static ResourceGroupManager& getSingleton (void);
+
+			FileInfoListPtr listResourceFileInfo (const String& groupName, bool dirs = false);
+
+			/** Stand-in only: add a file of the given archive to the default resource group */
+			void addFileInfo (const Archive* archive, const String& fileName, size_t size);
+
+			/** Stand-in only: remove all files and archives */
+			void clear (void);
+
+			/** Stand-in only: returns an archive with the given name, which lives as long as the manager */
+			const Archive* getArchive (const String& name);
+
+		private:
+			FileInfoList mFileInfos;
+			std::vector< std::shared_ptr<Archive> > mArchives;
+	};
+}
+
+#endif
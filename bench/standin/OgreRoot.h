@@ -0,0 +1,34 @@
+/*
+  Stand-in for the Ogre headers, used by the benchmark only.
+*/
+#ifndef __OgreRoot_H__
+#define __OgreRoot_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreResourceGroupManager.h"
+#include "OgrePlugin.h"
+
+namespace Ogre
+{
+	class HlmsManager;
+
+	class Root
+	{
+		public:
+			static Root& getSingleton (void);
+			static Root* getSingletonPtr (void);
+
+			HlmsManager* getHlmsManager (void) { return 0; }
+			void installPlugin (Plugin* plugin) {}
+			void uninstallPlugin (Plugin* plugin) {}
+
+			/** The locations are only remembered */
+			void addResourceLocation (const String& name, const String& locType, const String& groupName);
+			const StringVector& getResourceLocations (void) const { return mResourceLocations; }
+
+		private:
+			StringVector mResourceLocations;
+	};
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+  Stand-in for the Ogre library, used by the benchmark only.
+*/
+#include "OgreRoot.h"
+#include "OgreLogManager.h"
+#include "OgreArchiveManager.h"
+#include <iostream>
+
+namespace Ogre
+{
+	String ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME = "General";
+
+	//---------------------------------------------------------------------
+	ResourceGroupManager& ResourceGroupManager::getSingleton (void)
+	{
+		static ResourceGroupManager resourceGroupManager;
+		return resourceGroupManager;
+	}
+	//---------------------------------------------------------------------
+	FileInfoListPtr ResourceGroupManager::listResourceFileInfo (const String& groupName, bool dirs)
+	{
+		// Ogre returns a new list for each call; so does the stand-in
+		return FileInfoListPtr(new FileInfoList(mFileInfos));
+	}
+	//---------------------------------------------------------------------
+	void ResourceGroupManager::addFileInfo (const Archive* archive, const String& fileName, size_t size)
+	{
+		FileInfo fileInfo;
+		fileInfo.archive = archive;
+		fileInfo.filename = fileName;
+		fileInfo.path = "";
+		fileInfo.basename = fileName;
+		fileInfo.compressedSize = size;
+		fileInfo.uncompressedSize = size;
+		mFileInfos.push_back(fileInfo);
+	}
+	//---------------------------------------------------------------------
+	void ResourceGroupManager::clear (void)
+	{
+		mFileInfos.clear();
+		mArchives.clear();
+	}
+	//---------------------------------------------------------------------
+	const Archive* ResourceGroupManager::getArchive (const String& name)
+	{
+		std::vector< std::shared_ptr<Archive> >::iterator it;
+		for (it = mArchives.begin(); it != mArchives.end(); ++it)
+			if ((*it)->getName() == name)
+				return it->get();
+
+		mArchives.push_back(std::shared_ptr<Archive>(new Archive(name, "FileSystem")));
+		return mArchives.back().get();
+	}
+	//---------------------------------------------------------------------
+	ArchiveManager& ArchiveManager::getSingleton (void)
+	{
+		static ArchiveManager archiveManager;
+		return archiveManager;
+	}
+	//---------------------------------------------------------------------
+	void ArchiveManager::addArchiveFactory (ArchiveFactory* factory)
+	{
+		mFactories[factory->getType()] = factory;
+	}
+	//---------------------------------------------------------------------
+	ArchiveFactory* ArchiveManager::getArchiveFactory (const String& archiveType)
+	{
+		std::map<String, ArchiveFactory*>::iterator it = mFactories.find(archiveType);
+		return it == mFactories.end() ? 0 : it->second;
+	}
+	//---------------------------------------------------------------------
+	Root& Root::getSingleton (void)
+	{
+		static Root root;
+		return root;
+	}
+	//---------------------------------------------------------------------
+	Root* Root::getSingletonPtr (void)
+	{
+		return &getSingleton();
+	}
+	//---------------------------------------------------------------------
+	void Root::addResourceLocation (const String& name, const String& locType, const String& groupName)
+	{
+		mResourceLocations.push_back(name);
+	}
+	//---------------------------------------------------------------------
+	LogManager& LogManager::getSingleton (void)
+	{
+		static LogManager logManager;
+		return logManager;
+	}
+	//---------------------------------------------------------------------
+	void LogManager::logMessage (const String& message)
+	{
+		if (mQuiet)
+			return;
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		std::cerr << message << std::endl;
+	}
+}
@@ -0,0 +1,90 @@
+/*
+  Stand-in for the plugin interface of the HLMS Editor, used by the benchmark only. It has the same members
+  as the header of the editor, as far as the plugin uses them.
+*/
+#ifndef __HLMS_EDITOR_PLUGIN_H__
+#define __HLMS_EDITOR_PLUGIN_H__
+
+#include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+	static const String GENERAL_HLMS_PLUGIN_NAME = "HlmsEditorPlugin";
+
+	enum HlmsEditorPluginActionFlag
+	{
+		PAF_PRE_IMPORT_OPEN_FILE_DIALOG = 1 << 0,
+		PAF_PRE_IMPORT_MK_DIR = 1 << 1,
+		PAF_POST_IMPORT_OPEN_PROJECT = 1 << 2,
+		PAF_POST_IMPORT_SAVE_RESOURCE_LOCATIONS = 1 << 3,
+		PAF_PRE_EXPORT_SETTINGS_DIALOG = 1 << 4,
+		PAF_PRE_EXPORT_OPEN_DIR_DIALOG = 1 << 5,
+		PAF_PRE_EXPORT_TEXTURES_USED_BY_DATABLOCK = 1 << 6
+	};
+
+	class HlmsEditorPluginData
+	{
+		public:
+			enum PROPERTY_TYPE
+			{
+				INCORRECT = 0,
+				BOOL,
+				INT,
+				UINT,
+				FLOAT,
+				STRING
+			};
+
+			struct PLUGIN_PROPERTY
+			{
+				String propertyName;
+				String labelName;
+				String info;
+				PROPERTY_TYPE type;
+				String stringValue;
+				int intValue;
+				unsigned int uintValue;
+				float floatValue;
+				bool boolValue;
+			};
+
+			String mInProjectName;
+			String mInProjectPath;
+			String mInFileDialogName;
+			String mInFileDialogBaseName;
+			String mInFileDialogPath;
+			String mInExportPath;
+			String mInImportPath;
+			String mInMaterialFileName;
+			String mInTextureFileName;
+			String mInMeshesFileName;
+			std::vector<String> mInMaterialFileNameVector;
+			std::vector<String> mInTextureFileNameVector;
+			std::vector<String> mInTexturesUsedByDatablocks;
+			std::vector<String> mInMeshFileNames;
+			std::map<std::string, PLUGIN_PROPERTY> mInPropertiesMap;
+			String mOutReference;
+			String mOutSuccessText;
+			String mOutErrorText;
+	};
+
+	class HlmsEditorPlugin
+	{
+		public:
+			virtual ~HlmsEditorPlugin (void) {}
+			virtual bool isImport (void) const = 0;
+			virtual bool isExport (void) const = 0;
+			virtual const String& getImportMenuText (void) const = 0;
+			virtual const String& getExportMenuText (void) const = 0;
+			virtual bool executeImport (HlmsEditorPluginData* data) = 0;
+			virtual bool executeExport (HlmsEditorPluginData* data) = 0;
+			virtual void performPreImportActions (void) = 0;
+			virtual void performPostImportActions (void) = 0;
+			virtual void performPreExportActions (void) = 0;
+			virtual void performPostExportActions (void) = 0;
+			virtual unsigned int getActionFlag (void) = 0;
+			virtual std::map<std::string, HlmsEditorPluginData::PLUGIN_PROPERTY> getProperties (void) = 0;
+	};
+}
+
+#endif
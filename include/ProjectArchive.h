@@ -0,0 +1,110 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectArchive_H__
+#define __ProjectArchive_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+#include "OgreArchive.h"
+#include "OgreArchiveFactory.h"
+#include "ProjectZipReader.h"
+#include <mutex>
+
+namespace Ogre
+{
+	/** Ogre archive that serves the files of an exported project straight from the zip file. The central directory
+		is read once, when the archive is loaded, and the files are found with the name index of the zip reader; a file
+		is only inflated when it is opened. The archive is read-only and, like the file system on Windows, not case sensitive.
+	*/
+	class ProjectArchive : public Archive
+	{
+		public:
+			ProjectArchive (const String& name, const String& archType);
+			~ProjectArchive (void);
+
+			/// @copydoc Archive::isCaseSensitive
+			bool isCaseSensitive (void) const;
+
+			/// @copydoc Archive::load
+			void load (void);
+
+			/// @copydoc Archive::unload
+			void unload (void);
+
+			/// @copydoc Archive::open
+			DataStreamPtr open (const String& filename, bool readOnly = true) const;
+
+			/// @copydoc Archive::list
+			StringVectorPtr list (bool recursive = true, bool dirs = false);
+
+			/// @copydoc Archive::listFileInfo
+			FileInfoListPtr listFileInfo (bool recursive = true, bool dirs = false);
+
+			/// @copydoc Archive::find
+			StringVectorPtr find (const String& pattern, bool recursive = true, bool dirs = false);
+
+			/// @copydoc Archive::findFileInfo
+			FileInfoListPtr findFileInfo (const String& pattern, bool recursive = true, bool dirs = false) const;
+
+			/// @copydoc Archive::exists
+			bool exists (const String& filename);
+
+			/// @copydoc Archive::getModifiedTime
+			time_t getModifiedTime (const String& filename);
+
+		protected:
+			FileInfo getFileInfo (const ImportEntry& entry) const;
+			const ImportEntry* findFile (const String& filename) const; // NULL if it does not exist or is a directory
+			static bool isDirectory (const String& nameInZip);
+
+		private:
+			mutable ProjectZipReader mZipReader; // Not case sensitive; opening a file moves the position in the zip file
+			mutable std::mutex mMutex; // Guards mZipReader
+	};
+
+	/** Factory of the archive type "ProjectZip"; the plugin registers it, so the zip file of an imported project
+		can be added as resource location with this type.
+	*/
+	class ProjectArchiveFactory : public ArchiveFactory
+	{
+		public:
+			static const String ARCHIVE_TYPE;
+
+			virtual ~ProjectArchiveFactory (void) {}
+
+			/// @copydoc FactoryObj::getType
+			const String& getType (void) const;
+
+			/// @copydoc ArchiveFactory::createInstance
+			Archive* createInstance (const String& name, bool readOnly);
+
+			/// @copydoc FactoryObj::destroyInstance
+			void destroyInstance (Archive* archive);
+	};
+}
+
+#endif
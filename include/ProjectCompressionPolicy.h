@@ -0,0 +1,86 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectCompressionPolicy_H__
+#define __ProjectCompressionPolicy_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+#include "zlib.h"
+
+namespace Ogre
+{
+	/** Compression method, level and strategy of one zip entry */
+	struct CompressionSettings
+	{
+		int method; // 0 (store) or Z_DEFLATED
+		int level;
+		int strategy;
+	};
+
+	/** Chooses the compression of each exported entry, based on its file type, the header of the file and the
+		entropy of the first bytes. Already compressed files (png, jpg, ...) are stored, block compressed textures
+		(BCn dds, ktx) use a fast level or Huffman only, data with long runs uses Z_RLE and text files use the
+		maximum level.
+	*/
+	class ProjectCompressionPolicy
+	{
+		public:
+			ProjectCompressionPolicy (void);
+			~ProjectCompressionPolicy (void);
+
+			/** If disabled, all entries are compressed with the default level */
+			void setEnabled (bool enabled);
+			bool isEnabled (void) const;
+
+			/** Level used for entries that do not need a specific compression */
+			void setDefaultLevel (int level);
+			int getDefaultLevel (void) const;
+
+			/** Entries with a projected saving (in percent) below this value are stored */
+			void setMinimumSavings (int percentage);
+			int getMinimumSavings (void) const;
+
+			/** Returns the compression of an entry; the sample contains the first bytes of the entry */
+			CompressionSettings getSettings (const String& nameInZip, const unsigned char* sample, size_t sampleLength) const;
+
+			/** Returns the projected saving (in percent) of the sample, based on its entropy */
+			static int getProjectedSavings (const unsigned char* sample, size_t sampleLength);
+
+		protected:
+			bool isCompressedFormat (const String& extension, const unsigned char* sample, size_t sampleLength) const;
+			bool isBlockCompressedTexture (const String& extension, const unsigned char* sample, size_t sampleLength) const;
+			bool isText (const String& extension, const unsigned char* sample, size_t sampleLength) const;
+			bool hasLongRuns (const unsigned char* sample, size_t sampleLength) const;
+
+		private:
+			bool mEnabled;
+			int mDefaultLevel;
+			int mMinimumSavings;
+	};
+}
+
+#endif
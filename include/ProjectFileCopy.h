@@ -0,0 +1,78 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectFileCopy_H__
+#define __ProjectFileCopy_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+
+namespace Ogre
+{
+	class ProjectJobProgress;
+
+	/** Copies a file with the cheapest method the platform and file system offer. On Linux the methods are tried in
+		order: a reflink (the destination shares the blocks of the source, which is near-instant on XFS and btrfs), an
+		in-kernel copy with copy_file_range, sendfile, and finally a buffered read/write loop. A method that is not
+		supported falls through to the next one and continues where the previous one stopped. Windows uses CopyFileEx.
+	*/
+	class ProjectFileCopy
+	{
+		public:
+			enum Method
+			{
+				METHOD_NONE,
+				METHOD_CLONE,
+				METHOD_COPY_FILE_RANGE,
+				METHOD_SENDFILE,
+				METHOD_BUFFERED,
+				METHOD_COPY_FILE_EX
+			};
+
+			ProjectFileCopy (void);
+			~ProjectFileCopy (void);
+
+			/** Copy the source file to the destination file, which is created or truncated. The copy is done in
+				chunks; if the progress is cancelled it stops within a chunk. Returns false on error or cancellation;
+				the partial destination file is removed and getErrorText describes the error.
+			*/
+			bool copy (const String& fileNameSource, const String& fileNameDestination, const ProjectJobProgress* progress = NULL);
+
+			/** The method that copied the (last part of the) file */
+			Method getMethod (void) const;
+
+			const String& getErrorText (void) const;
+
+		protected:
+			bool setError (const String& errorText);
+
+		private:
+			Method mMethod;
+			String mErrorText;
+	};
+}
+
+#endif
@@ -31,7 +31,12 @@ THE SOFTWARE.
 #include "ProjectImportExportPluginPrerequisites.h"
 #include "OgrePlugin.h"
 #include "hlms_editor_plugin.h"
-#include "unzip.h"
+#include "ProjectZipReader.h"
+#include "ProjectArchive.h"
+#include "ProjectZipWriter.h"
+#include "ProjectNameIndex.h"
+#include "ProjectTextureResolver.h"
+#include "ProjectJob.h"
 
 namespace Ogre
 {
@@ -70,30 +75,50 @@ namespace Ogre
 			virtual unsigned int getActionFlag(void);
 			virtual std::map<std::string, HlmsEditorPluginData::PLUGIN_PROPERTY> getProperties(void);
 
+			/** Asynchronous import and export; executeImport and executeExport start a job and wait for it.
+				The job works on a copy of the data; mOutSuccessText, mOutErrorText and mOutReference of the original
+				data are set when the job completes, which is when pollJob() returns true. The callback is called by
+				the thread that calls pollJob(), so it may use Ogre and the editor. The data must stay valid until then.
+			*/
+			typedef std::function<void (bool success, HlmsEditorPluginData* data)> JobCallback;
+			bool startImport (HlmsEditorPluginData* data, const JobCallback& callback);
+			bool startExport (HlmsEditorPluginData* data, const JobCallback& callback);
+			bool pollJob (void); // Returns true if the job just completed
+			void cancelJob (void); // Cancelled work is discarded: no partial zip file or partially imported files remain
+			bool isJobRunning (void) const;
+			const ProjectJobProgress& getJobProgress (void) const; // Bytes and entries done versus total
+
 		protected:
-			bool loadMaterial (const String& fileName);
-			const String& getFullFileNameFromTextureList (const String& baseName, HlmsEditorPluginData* data);
-			const String& getFullFileNameFromResources (const String& baseName, HlmsEditorPluginData* data);
-			bool validateZip (const char* zipfilename, HlmsEditorPluginData* data);
-			bool unzip (const char* filename, HlmsEditorPluginData* data);
-			int isLargeFile(const char* filename);
-			bool createProjectFileForImport (HlmsEditorPluginData* data);
+			bool importProject (HlmsEditorPluginData* data); // Executed by the job
+			bool exportProject (HlmsEditorPluginData* data); // Executed by the job
+			void prepareImport (HlmsEditorPluginData* data); // Sets the project path; the first step of importProject, which the other steps depend on
+			const String& getProjectPath (void) const;
+			bool validateZip (const ProjectZipReader& zipReader, HlmsEditorPluginData* data);
+			bool unzip (ProjectZipReader& zipReader,
+				HlmsEditorPluginData* data,
+				const ProjectNameIndex* excluded = NULL,
+				const ProjectNameIndex* thumbNames = NULL); // Excluded entries and the cfg files are not extracted; thumbs go to ../common/thumbs
+			bool readContentFromZip (ProjectZipReader& zipReader, const String& nameInZip, String* content); // Inflate an entry into memory
+			bool readTextureNamesFromZip (ProjectZipReader& zipReader, ProjectNameIndex* textureNames); // The textures in textures.cfg
+			bool readThumbNamesFromZip (ProjectZipReader& zipReader, ProjectNameIndex* thumbNames); // The thumbs of the materials in materials.cfg
+			bool createProjectFileForImport (ProjectZipReader& zipReader, HlmsEditorPluginData* data);
 			bool createProjectFileForExport (HlmsEditorPluginData* data);
-			bool createMaterialCfgFileForImport (HlmsEditorPluginData* data); // Used to create a material file WITH paths in the file
+			bool createMaterialCfgFileForImport (ProjectZipReader& zipReader, HlmsEditorPluginData* data); // Used to create a material file WITH paths in the file
 			bool createMaterialCfgFileForExport (HlmsEditorPluginData* data); // Used to create a base material file without paths in the file
-			bool createTextureCfgFileForImport (HlmsEditorPluginData* data); // Used to create a texture file WITH paths in the file
+			bool createTextureCfgFileForImport (ProjectZipReader& zipReader, HlmsEditorPluginData* data); // Used to create a texture file WITH paths in the file
 			bool createTextureCfgFileForExport (HlmsEditorPluginData* data); // Used to create a base texture file without paths in the file
-			bool isMeshesCfgFileForImport (HlmsEditorPluginData* data); // Returns true if there is a meshes.cfg in the .zip file
-			bool createMeshesCfgFileForImport (HlmsEditorPluginData* data); // Used to create an optional meshes file WITH paths in the file
+			bool isMeshesCfgFileForImport (const ProjectZipReader& zipReader); // Returns true if there is a meshes.cfg in the .zip file
+			bool createMeshesCfgFileForImport (ProjectZipReader& zipReader, HlmsEditorPluginData* data); // Used to create an optional meshes file WITH paths in the file
 			bool createMeshesCfgFileForExport (HlmsEditorPluginData* data); // Used to create a base meshes file without paths in the file
-			void removeFromUniqueTextureFiles(const String& fileName);
-			bool isDestinationFileAvailableInVector (const String& fileName);
-			void copyFile (const String& fileNameSource, const String& fileNameDestination);
-			void mySleep (clock_t sec);
+			void addFileToExport (const String& fileNameSource, const String& nameInZip);
+			void addContentToExport (const String& content, const String& nameInZip);
+			bool addTextureToExport (const String& fileNameSource, const String& nameInZip); // Returns false if the texture was already added
+			bool copyFile (const String& fileNameSource, const String& fileNameDestination, String* errorText = NULL); // Returns false on error or cancellation; the error is logged
 
 		private:
-			std::vector<String> mFileNamesDestination;
-			std::vector<String> mUniqueTextureFiles; // List of all texture files in the zip
+			std::vector<ExportEntry> mExportEntries; // All entries of the exported zip file, in order
+			ProjectNameIndex mTextureEntries; // Name of each texture in the zip to its index in mExportEntries
+			ProjectNameIndex mUniqueTextureFiles; // List of all texture files in the zip
 			String mProjectPath;
 			String mNameProject;
 			String mFileNameProject;
@@ -101,6 +126,11 @@ namespace Ogre
 			String mFileNameTextures;
 			String mFileNameMeshes;
 			std::map<std::string, HlmsEditorPluginData::PLUGIN_PROPERTY> mProperties;
+			ProjectJob mJob;
+			HlmsEditorPluginData mJobData; // Copy of the data the job works on
+			ProjectTextureResolver mTextureResolver; // Built when the export starts, because it uses the Ogre resources
+			ProjectArchiveFactory mArchiveFactory; // Serves the textures of an imported project from its zip file
+			String mMountedZip; // Zip file of the last import, if it is added to the resources as archive
 
 	};
 }
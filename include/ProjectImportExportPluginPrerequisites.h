@@ -51,4 +51,21 @@ THE SOFTWARE.
 #   define _ProjectImportExport
 #endif
 
+//-----------------------------------------------------------------------
+// File functions (64 bit)
+//-----------------------------------------------------------------------
+#ifdef __APPLE__
+	// In darwin and perhaps other BSD variants off_t is a 64 bit value, hence no need for specific 64 bit functions
+#	define FOPEN_FUNC(filename, mode) fopen(filename, mode)
+#	define FTELLO_FUNC(stream) ftello(stream)
+#	define FSEEKO_FUNC(stream, offset, origin) fseeko(stream, offset, origin)
+#else
+#	define FOPEN_FUNC(filename, mode) fopen64(filename, mode)
+#	define FTELLO_FUNC(stream) ftello64(stream)
+#	define FSEEKO_FUNC(stream, offset, origin) fseeko64(stream, offset, origin)
+#endif
+
+#define WRITEBUFFERSIZE (262144)
+#define MAX_FILENAME 512
+
 #endif
@@ -0,0 +1,120 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectJob_H__
+#define __ProjectJob_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+#include <thread>
+#include <atomic>
+#include <functional>
+
+namespace Ogre
+{
+	/** Progress of a running import or export, shared between the job and the threads that report to it.
+		All members may be read and updated from any thread.
+	*/
+	class ProjectJobProgress
+	{
+		public:
+			ProjectJobProgress (void);
+			~ProjectJobProgress (void);
+
+			/** Set all counters to zero and clear the cancel request */
+			void reset (void);
+
+			/** Add to the amount of work that must be done */
+			void addTotal (uint64 bytes, size_t entries);
+
+			/** Add to the amount of work that is done */
+			void addDone (uint64 bytes, size_t entries);
+
+			/** Request the job to stop; the job checks this after each I/O buffer */
+			void cancel (void);
+			bool isCancelled (void) const;
+
+			uint64 getBytesDone (void) const;
+			uint64 getBytesTotal (void) const;
+			size_t getEntriesDone (void) const;
+			size_t getEntriesTotal (void) const;
+
+		private:
+			std::atomic<uint64> mBytesDone;
+			std::atomic<uint64> mBytesTotal;
+			std::atomic<size_t> mEntriesDone;
+			std::atomic<size_t> mEntriesTotal;
+			std::atomic<bool> mCancelled;
+	};
+
+	/** Runs one import or export on a background thread. The completion function is not called by the background
+		thread, but by the thread that calls poll() or wait(), so it can safely use Ogre and the editor.
+	*/
+	class ProjectJob
+	{
+		public:
+			typedef std::function<bool (void)> Work;
+			typedef std::function<void (bool success)> Completion;
+
+			ProjectJob (void);
+
+			/** A job that is still running is cancelled; its completion function is not called */
+			~ProjectJob (void);
+
+			/** Start the work on a background thread; returns false if a job is already running */
+			bool start (const Work& work, const Completion& completion);
+
+			/** Request the running job to stop; it completes (unsuccessfully) as soon as possible */
+			void cancel (void);
+
+			/** Returns true from start() until the completion function is called */
+			bool isRunning (void) const;
+
+			/** If the work is finished, call the completion function and return true; returns false otherwise.
+				This function does not block; the editor can call it periodically.
+			*/
+			bool poll (void);
+
+			/** Block until the work is finished, call the completion function and return the result of the work */
+			bool wait (void);
+
+			ProjectJobProgress& getProgress (void);
+			const ProjectJobProgress& getProgress (void) const;
+
+		protected:
+			void complete (void);
+
+		private:
+			std::thread mThread;
+			std::atomic<bool> mFinished;
+			bool mRunning;
+			bool mResult;
+			Completion mCompletion;
+			ProjectJobProgress mProgress;
+	};
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectMappedFile_H__
+#define __ProjectMappedFile_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+
+namespace Ogre
+{
+	/** Destination file of an extracted entry, created with its final size (the space is preallocated) and mapped
+		into memory, so the entry can be inflated straight into the file.
+	*/
+	class ProjectMappedFile
+	{
+		public:
+			ProjectMappedFile (void);
+			~ProjectMappedFile (void);
+
+			/** Create (or truncate) the file with the given size, which must be > 0, and map it for writing.
+				Returns false if the file cannot be created, preallocated or mapped; the caller can write it in another way.
+			*/
+			bool create (const String& fileName, uint64 size);
+
+			/** Unmap and close the file. Returns false if the contents could not be written */
+			bool close (void);
+
+			/** Start of the mapped file; NULL if no file is mapped */
+			unsigned char* getData (void) const;
+
+			uint64 getSize (void) const;
+
+		private:
+			unsigned char* mData;
+			uint64 mSize;
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+			void* mFile;
+#else
+			int mFile;
+#endif
+	};
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectMaterialScanner_H__
+#define __ProjectMaterialScanner_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+#include <vector>
+
+namespace Ogre
+{
+	/** Scans HLMS material (Json) files for the textures they reference, without creating datablocks.
+		Only the values of "texture" keys inside the "pbs" and "unlit" sections are collected; a value is either
+		a string or an array of which the strings are used. Everything else is skipped without being decoded.
+		The collected names are base names (a path in the texture name is stripped).
+	*/
+	class ProjectMaterialScanner
+	{
+		public:
+			ProjectMaterialScanner (void);
+			~ProjectMaterialScanner (void);
+
+			/** Scan a material file and append the texture names to textureNames; returns false if the file
+				cannot be read or is not valid Json. The names found before an error are still appended.
+			*/
+			bool scanFile (const String& fileName, std::vector<String>& textureNames);
+
+			/** Scan a Json text in memory */
+			bool scan (const char* json, size_t length, std::vector<String>& textureNames);
+
+			const String& getErrorText (void) const;
+
+		protected:
+			bool parseValue (size_t depth, bool inSection, bool isTexture, std::vector<String>& textureNames);
+			bool parseObject (size_t depth, bool inSection, std::vector<String>& textureNames);
+			bool parseArray (size_t depth, bool inSection, bool isTexture, std::vector<String>& textureNames);
+			bool parseString (String* decoded);
+			bool skipLiteral (void);
+			void skipWhitespace (void);
+			bool setError (const String& errorText);
+
+		private:
+			std::vector<char> mBuffer; // Reused for each file
+			String mKey; // Reused for each key
+			const char* mCurrent;
+			const char* mEnd;
+			String mErrorText;
+	};
+}
+
+#endif
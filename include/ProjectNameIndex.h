@@ -0,0 +1,84 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectNameIndex_H__
+#define __ProjectNameIndex_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+#include <vector>
+#include <unordered_map>
+
+namespace Ogre
+{
+	/** Set of (file) names with constant time lookup and removal, case insensitive unless requested otherwise.
+		The names keep their original spelling and the order in which they were added; a removed name leaves a gap,
+		so the positions of the other names do not change. Each name carries a value, for example an index in another list.
+	*/
+	class ProjectNameIndex
+	{
+		public:
+			static const size_t NOT_FOUND = (size_t)-1;
+
+			ProjectNameIndex (bool caseSensitive = false);
+			~ProjectNameIndex (void);
+
+			/** Add a name; returns false (and does nothing) if the name is already present */
+			bool add (const String& name, size_t value = 0);
+
+			/** Returns the value of a name, or NOT_FOUND if the name is not present */
+			size_t find (const String& name) const;
+
+			/** Remove a name; returns false if the name is not present */
+			bool remove (const String& name);
+
+			void clear (void);
+
+			/** Number of positions, including the removed names */
+			size_t getCount (void) const;
+
+			/** Returns true if the name at the position is removed */
+			bool isRemoved (size_t position) const;
+
+			/** Returns the name at the position, in its original spelling */
+			const String& getName (size_t position) const;
+
+			/** Returns the value of the name at the position */
+			size_t getValue (size_t position) const;
+
+		protected:
+			String fold (const String& name) const;
+
+		private:
+			std::vector<String> mNames;
+			std::vector<size_t> mValues;
+			std::vector<bool> mRemoved;
+			std::unordered_map<String, size_t> mPositions; // Folded (upper case) name to position
+			bool mCaseSensitive; // Names are not folded
+	};
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectTextureResolver_H__
+#define __ProjectTextureResolver_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+#include "OgreArchive.h"
+#include <vector>
+#include <unordered_map>
+
+namespace Ogre
+{
+	/** Resolves the base name of a texture to its full qualified file name. The Ogre resources (default resource
+		group) and the texture list of the texture browser are indexed once by build(); each lookup is a single
+		hash lookup. If a base name occurs more than once, the first occurrence is used.
+	*/
+	class ProjectTextureResolver
+	{
+		public:
+			ProjectTextureResolver (void);
+			~ProjectTextureResolver (void);
+
+			/** Index the Ogre resources and the given texture list */
+			void build (const std::vector<String>& textureFileNames);
+
+			void clear (void);
+
+			/** Returns the full qualified name from the Ogre resources, or an empty string if it is not found */
+			String getFullFileNameFromResources (const String& baseName) const;
+
+			/** Returns the full qualified name from the texture list, or an empty string if it is not found */
+			String getFullFileNameFromTextureList (const String& baseName) const;
+
+			/** Returns the file with the given full qualified name if it is in a ProjectArchive (the zip file of a
+				mounted import); such a file cannot be opened by its name, but must be read with Archive::open.
+				Returns NULL for all other names. The file info is valid until the next build() or clear().
+			*/
+			const FileInfo* getArchiveFile (const String& fullFileName) const;
+
+		private:
+			std::unordered_map<String, String> mResourceFileNames;
+			std::unordered_map<String, String> mTextureListFileNames;
+			std::unordered_map<String, FileInfo> mArchiveFiles; // Full qualified name to the file in its ProjectArchive
+	};
+}
+
+#endif
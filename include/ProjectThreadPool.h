@@ -0,0 +1,83 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectThreadPool_H__
+#define __ProjectThreadPool_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+
+namespace Ogre
+{
+	/** Simple fixed size pool of worker threads, used by the plugin to compress and decompress in parallel.
+		Tasks are executed in the order in which they are submitted.
+	*/
+	class ProjectThreadPool
+	{
+		public:
+			/** Create the pool; if numberOfThreads is 0, the number of hardware threads is used */
+			ProjectThreadPool (size_t numberOfThreads = 0);
+			~ProjectThreadPool (void);
+
+			/** Returns the number of worker threads */
+			size_t getNumberOfThreads (void) const;
+
+			/** Add a task to the queue; the returned future becomes ready when the task is executed */
+			template <typename F>
+			std::future<typename std::result_of<F()>::type> submit (F f)
+			{
+				typedef typename std::result_of<F()>::type ResultType;
+				std::shared_ptr< std::packaged_task<ResultType()> > task(new std::packaged_task<ResultType()>(f));
+				std::future<ResultType> result = task->get_future();
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+					mTasks.push_back([task]() { (*task)(); });
+				}
+				mCondition.notify_one();
+				return result;
+			}
+
+		protected:
+			void workerLoop (void);
+
+		private:
+			std::vector<std::thread> mThreads;
+			std::deque< std::function<void()> > mTasks;
+			std::mutex mMutex;
+			std::condition_variable mCondition;
+			bool mStop;
+	};
+}
+
+#endif
@@ -0,0 +1,120 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectZipReader_H__
+#define __ProjectZipReader_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+#include "ProjectJob.h"
+#include "ProjectNameIndex.h"
+#include "unzip.h"
+#include <vector>
+
+namespace Ogre
+{
+	/** An entry of the imported zip file, as recorded in the central directory */
+	struct ImportEntry
+	{
+		String nameInZip;
+		unz64_file_pos position; // Position of the entry in the central directory
+		uLong crc;
+		ZPOS64_T compressedSize;
+		ZPOS64_T uncompressedSize;
+	};
+
+	/** Reads the imported zip file. The central directory is read once, when the zip file is opened, into a table
+		of entries and a name index; the entries are validated and extracted from that table with the same handle, so
+		the central directory is not walked again, and an entry is found by name in constant time.
+	*/
+	class ProjectZipReader
+	{
+		public:
+			/** The names of the entries are case sensitive, as they are in the zip file, unless requested otherwise */
+			ProjectZipReader (bool caseSensitive = true);
+			~ProjectZipReader (void);
+
+			/** Open a zip file for reading. The file is memory-mapped if possible, so unzip inflates its entries
+				straight from the mapped view; otherwise it is read with the default io functions.
+			*/
+			static unzFile openZipFile (const String& zipName);
+
+			/** Open the zip file (read-only) and read its central directory. Returns false in case of an error (see getErrorText) */
+			bool open (const String& zipName);
+
+			/** Open another handle on the zip file of an opened reader, without reading the central directory again.
+				The entries of that reader can be extracted with it, for example by another thread.
+			*/
+			bool openForExtraction (const ProjectZipReader& zipReader);
+
+			void close (void);
+
+			/** All entries, in the order of the central directory */
+			const std::vector<ImportEntry>& getEntries (void) const;
+
+			/** Returns true if the zip file has an entry with the given name */
+			bool hasEntry (const String& nameInZip) const;
+
+			/** Returns the entry with the given name, or NULL if the zip file has no such entry.
+				If the name occurs more than once, the first entry in the central directory is returned.
+			*/
+			const ImportEntry* findEntry (const String& nameInZip) const;
+
+			/** Name of each entry to its index in getEntries(); a name that occurs more than once is only indexed once */
+			const ProjectNameIndex& getIndex (void) const;
+
+			/** Read an entry into memory of (at least) its uncompressed size */
+			bool readEntry (const ImportEntry& entry, void* data);
+
+			/** Extract an entry to a file. The file is created with its final size and mapped, and the entry is inflated
+				straight into it; if the file cannot be mapped, it is written per buffer. The progress (may be NULL) is
+				updated per chunk; extraction stops as soon as it is cancelled. A partially written file is removed.
+			*/
+			bool extractEntry (const ImportEntry& entry, const String& fileName, ProjectJobProgress* progress);
+
+			/** Returns the description of the last error */
+			const String& getErrorText (void) const;
+
+		protected:
+			/** Read the opened entry into memory of exactly its uncompressed size */
+			bool readCurrentEntry (unsigned char* data, uint64 size, ProjectJobProgress* progress);
+
+			/** Read the opened entry per buffer and write it to a file */
+			bool writeCurrentEntry (FILE* out, const String& fileName, ProjectJobProgress* progress);
+
+			void buildIndex (void);
+
+		private:
+			String mZipName;
+			unzFile mZipFile;
+			std::vector<ImportEntry> mEntries;
+			ProjectNameIndex mIndex;
+			std::vector<char> mBuffer;
+			String mErrorText;
+	};
+}
+
+#endif
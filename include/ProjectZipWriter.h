@@ -0,0 +1,164 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __ProjectZipWriter_H__
+#define __ProjectZipWriter_H__
+
+#include "ProjectImportExportPluginPrerequisites.h"
+#include "ProjectThreadPool.h"
+#include "ProjectCompressionPolicy.h"
+#include "ProjectJob.h"
+#include "OgreArchive.h"
+#include "zip.h"
+#include "unzip.h"
+
+namespace Ogre
+{
+	/** An entry in the exported zip file. The data is either streamed from fileNameSource or, if inMemory is set,
+		taken from content; nameInZip is independent of the location of the source file. If archiveFile is set, the
+		source is a file in a ProjectArchive (fileNameSource is then only used in messages).
+	*/
+	struct ExportEntry
+	{
+		String nameInZip;
+		String fileNameSource;
+		String content;
+		bool inMemory;
+		const FileInfo* archiveFile;
+	};
+
+	/** Creates the exported zip file. Entries are deflated in parallel by a pool of worker threads, each into
+		its own buffer. The calling thread is the only one that writes to the zip file; it appends the finished
+		entries in the order of the entry list (the archive is deterministic) and minizip creates the central
+		directory from the collected crc's and sizes.
+		Source files larger than the block threshold are split into blocks, which are deflated in parallel (each
+		block uses the tail of the previous block as dictionary) and stitched together into one deflate stream.
+		During an incremental export, entries of which the source is unchanged (same size, modification time and
+		crc) are copied as-is from the previous version of the zip file, without decompressing and compressing.
+		Files in a ProjectArchive are read with Archive::open by the worker threads, which that archive allows;
+		they are always compressed again, as a whole.
+	*/
+	class ProjectZipWriter
+	{
+		public:
+			ProjectZipWriter (void);
+			~ProjectZipWriter (void);
+
+			/** Set the number of worker threads; 0 means the number of hardware threads */
+			void setNumberOfThreads (size_t numberOfThreads);
+
+			/** Compressed entries larger than this number of bytes are moved from memory to a temporary file */
+			void setSpillThreshold (size_t spillThreshold);
+
+			/** Source files larger than this number of bytes are compressed block-parallel */
+			void setBlockThreshold (ZPOS64_T blockThreshold);
+
+			/** Set the policy that chooses the compression of each entry */
+			void setCompressionPolicy (const ProjectCompressionPolicy& policy);
+
+			/** If set, the unchanged entries of an existing zip file (with the same name) are reused */
+			void setIncremental (bool incremental);
+
+			/** Report the progress to this object and stop as soon as it is cancelled; NULL means no reporting */
+			void setProgress (ProjectJobProgress* progress);
+
+			/** Create the zip file with the given entries. Returns false in case of an error (see getErrorText) */
+			bool write (const String& zipName, const std::vector<ExportEntry>& entries);
+
+			/** Returns the description of the last error */
+			const String& getErrorText (void) const;
+
+		protected:
+			/** Entry of the previous version of the zip file */
+			struct PreviousEntry
+			{
+				unz64_file_pos position;
+				uLong crc;
+				ZPOS64_T uncompressedSize;
+				ZPOS64_T compressedSize;
+				uLong dosDate;
+			};
+
+			/** Result of compressing one entry on a worker thread */
+			struct CompressedEntry
+			{
+				bool skipped; // Source file does not exist
+				bool blockParallel; // Compressed by appendBlockParallelEntry instead of compressEntry
+				bool reuse; // Copied from the previous zip file
+				const PreviousEntry* previous; // Entry in the previous zip file with the same name, size and date
+				ZPOS64_T sourceSize;
+				bool valid;
+				String errorText;
+				zip_fileinfo zi;
+				int method;
+				int level;
+				uLong crc;
+				ZPOS64_T uncompressedSize;
+				ZPOS64_T compressedSize;
+				std::string data; // Compressed data, as long as it is below the spill threshold
+				FILE* spill; // Temporary file with the compressed data, if it exceeds the spill threshold
+			};
+
+			/** Result of compressing one block of a large entry on a worker thread */
+			struct CompressedBlock
+			{
+				bool valid;
+				uLong crc;
+				std::string data;
+			};
+
+			void prepareEntry (const ExportEntry& entry, CompressedEntry* result);
+			void compressEntry (const ExportEntry& entry, CompressedEntry* result);
+			void compressBlock (const ExportEntry& entry, ZPOS64_T offset, size_t length, bool last,
+				const CompressionSettings& settings, CompressedBlock* result);
+			bool appendOutput (CompressedEntry* result, const void* buf, size_t len);
+			bool appendEntry (zipFile zf, const ExportEntry& entry, CompressedEntry* result);
+			bool appendBlockParallelEntry (zipFile zf, const ExportEntry& entry, CompressedEntry* result, ProjectThreadPool& pool);
+			bool openEntryInZip (zipFile zf, const ExportEntry& entry, CompressedEntry* result);
+			void releaseEntry (CompressedEntry* result);
+			bool statSourceFile (const char* fileName, zip_fileinfo* zi, ZPOS64_T* size);
+			uLong getDosDate (const tm_zip& date);
+			bool checksumFile (FILE* fin, uLong* crc);
+			void openPreviousArchive (const String& zipName);
+			void closePreviousArchive (void);
+			bool copyPreviousEntry (zipFile zf, const ExportEntry& entry, CompressedEntry* result);
+			bool isCancelled (void) const;
+
+		private:
+			size_t mNumberOfThreads;
+			size_t mSpillThreshold;
+			ZPOS64_T mBlockThreshold;
+			ProjectCompressionPolicy mPolicy;
+			bool mIncremental;
+			unzFile mPreviousZip;
+			std::map<String, PreviousEntry> mPreviousEntries;
+			ProjectJobProgress* mProgress;
+			String mErrorText;
+	};
+}
+
+#endif
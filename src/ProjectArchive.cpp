@@ -0,0 +1,219 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectArchive.h"
+#include "OgreDataStream.h"
+#include "OgreLogManager.h"
+#include <sys/stat.h>
+
+namespace Ogre
+{
+	const String ProjectArchiveFactory::ARCHIVE_TYPE = "ProjectZip";
+
+	//---------------------------------------------------------------------
+	ProjectArchive::ProjectArchive (const String& name, const String& archType) :
+		Archive(name, archType),
+		mZipReader(false)
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectArchive::~ProjectArchive (void)
+	{
+		unload();
+	}
+	//---------------------------------------------------------------------
+	bool ProjectArchive::isCaseSensitive (void) const
+	{
+		return false;
+	}
+	//---------------------------------------------------------------------
+	void ProjectArchive::load (void)
+	{
+		// A duplicate name keeps its first entry
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (!mZipReader.open(mName))
+		{
+			// The archive stays empty
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: " + mZipReader.getErrorText());
+		}
+	}
+	//---------------------------------------------------------------------
+	void ProjectArchive::unload (void)
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mZipReader.close();
+	}
+	//---------------------------------------------------------------------
+	DataStreamPtr ProjectArchive::open (const String& filename, bool readOnly) const
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		const ImportEntry* entry = findFile(filename);
+		if (entry == NULL)
+			return DataStreamPtr();
+
+		// The file is inflated straight into the memory of the stream
+		MemoryDataStream* stream = OGRE_NEW MemoryDataStream(filename, (size_t)entry->uncompressedSize, true, true);
+		if (entry->uncompressedSize > 0 && !mZipReader.readEntry(*entry, stream->getPtr()))
+		{
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: " + mZipReader.getErrorText());
+			OGRE_DELETE stream;
+			return DataStreamPtr();
+		}
+
+		return DataStreamPtr(stream);
+	}
+	//---------------------------------------------------------------------
+	StringVectorPtr ProjectArchive::list (bool recursive, bool dirs)
+	{
+		StringVectorPtr result = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+		if (dirs)
+			return result;
+
+		const ProjectNameIndex& index = mZipReader.getIndex();
+		for (size_t i = 0; i < index.getCount(); ++i)
+			if (!index.isRemoved(i) && !isDirectory(index.getName(i)))
+				result->push_back(index.getName(i));
+
+		return result;
+	}
+	//---------------------------------------------------------------------
+	FileInfoListPtr ProjectArchive::listFileInfo (bool recursive, bool dirs)
+	{
+		FileInfoListPtr result = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+		if (dirs)
+			return result;
+
+		const std::vector<ImportEntry>& entries = mZipReader.getEntries();
+		const ProjectNameIndex& index = mZipReader.getIndex();
+		for (size_t i = 0; i < index.getCount(); ++i)
+			if (!index.isRemoved(i) && !isDirectory(index.getName(i)))
+				result->push_back(getFileInfo(entries[index.getValue(i)]));
+
+		return result;
+	}
+	//---------------------------------------------------------------------
+	StringVectorPtr ProjectArchive::find (const String& pattern, bool recursive, bool dirs)
+	{
+		StringVectorPtr result = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+		if (dirs)
+			return result;
+
+		const ProjectNameIndex& index = mZipReader.getIndex();
+		for (size_t i = 0; i < index.getCount(); ++i)
+			if (!index.isRemoved(i) && !isDirectory(index.getName(i)) && StringUtil::match(index.getName(i), pattern, false))
+				result->push_back(index.getName(i));
+
+		return result;
+	}
+	//---------------------------------------------------------------------
+	FileInfoListPtr ProjectArchive::findFileInfo (const String& pattern, bool recursive, bool dirs) const
+	{
+		FileInfoListPtr result = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+		if (dirs)
+			return result;
+
+		// Without wildcards, the index finds the file directly
+		if (pattern.find_first_of("*?") == String::npos)
+		{
+			const ImportEntry* entry = findFile(pattern);
+			if (entry)
+				result->push_back(getFileInfo(*entry));
+			return result;
+		}
+
+		const std::vector<ImportEntry>& entries = mZipReader.getEntries();
+		const ProjectNameIndex& index = mZipReader.getIndex();
+		for (size_t i = 0; i < index.getCount(); ++i)
+			if (!index.isRemoved(i) && !isDirectory(index.getName(i)) && StringUtil::match(index.getName(i), pattern, false))
+				result->push_back(getFileInfo(entries[index.getValue(i)]));
+
+		return result;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectArchive::exists (const String& filename)
+	{
+		return findFile(filename) != NULL;
+	}
+	//---------------------------------------------------------------------
+	time_t ProjectArchive::getModifiedTime (const String& filename)
+	{
+		// All files have the time of the zip file
+		struct stat st;
+		if (stat(mName.c_str(), &st) != 0)
+			return 0;
+
+		return st.st_mtime;
+	}
+	//---------------------------------------------------------------------
+	FileInfo ProjectArchive::getFileInfo (const ImportEntry& entry) const
+	{
+		FileInfo fileInfo;
+		fileInfo.archive = this;
+		fileInfo.filename = entry.nameInZip;
+		size_t separator = entry.nameInZip.find_last_of('/');
+		fileInfo.path = separator == String::npos ? "" : entry.nameInZip.substr(0, separator + 1);
+		fileInfo.basename = separator == String::npos ? entry.nameInZip : entry.nameInZip.substr(separator + 1);
+		fileInfo.compressedSize = (size_t)entry.compressedSize;
+		fileInfo.uncompressedSize = (size_t)entry.uncompressedSize;
+		return fileInfo;
+	}
+	//---------------------------------------------------------------------
+	const ImportEntry* ProjectArchive::findFile (const String& filename) const
+	{
+		// Directories are not served
+		const ImportEntry* entry = mZipReader.findEntry(filename);
+		if (entry == NULL || isDirectory(entry->nameInZip))
+			return NULL;
+
+		return entry;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectArchive::isDirectory (const String& nameInZip)
+	{
+		return nameInZip.empty() || nameInZip[nameInZip.size() - 1] == '/';
+	}
+	//---------------------------------------------------------------------
+	const String& ProjectArchiveFactory::getType (void) const
+	{
+		return ARCHIVE_TYPE;
+	}
+	//---------------------------------------------------------------------
+	Archive* ProjectArchiveFactory::createInstance (const String& name, bool readOnly)
+	{
+		// The archive can only be read
+		if (!readOnly)
+			return NULL;
+
+		return OGRE_NEW ProjectArchive(name, ARCHIVE_TYPE);
+	}
+	//---------------------------------------------------------------------
+	void ProjectArchiveFactory::destroyInstance (Archive* archive)
+	{
+		OGRE_DELETE archive;
+	}
+}
@@ -0,0 +1,237 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectCompressionPolicy.h"
+#include <cmath>
+
+namespace Ogre
+{
+	#define SAMPLE_SIZE 65536
+	#define HUFFMAN_ONLY_SAVINGS 15 // Block compressed textures with less projected savings are only Huffman coded
+	#define RUN_PERCENTAGE 50 // Percentage of bytes that are equal to their predecessor, before Z_RLE is used
+
+	//---------------------------------------------------------------------
+	ProjectCompressionPolicy::ProjectCompressionPolicy (void) :
+		mEnabled(true),
+		mDefaultLevel(Z_DEFAULT_COMPRESSION),
+		mMinimumSavings(3)
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectCompressionPolicy::~ProjectCompressionPolicy (void)
+	{
+	}
+	//---------------------------------------------------------------------
+	void ProjectCompressionPolicy::setEnabled (bool enabled)
+	{
+		mEnabled = enabled;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectCompressionPolicy::isEnabled (void) const
+	{
+		return mEnabled;
+	}
+	//---------------------------------------------------------------------
+	void ProjectCompressionPolicy::setDefaultLevel (int level)
+	{
+		mDefaultLevel = level;
+	}
+	//---------------------------------------------------------------------
+	int ProjectCompressionPolicy::getDefaultLevel (void) const
+	{
+		return mDefaultLevel;
+	}
+	//---------------------------------------------------------------------
+	void ProjectCompressionPolicy::setMinimumSavings (int percentage)
+	{
+		mMinimumSavings = percentage;
+	}
+	//---------------------------------------------------------------------
+	int ProjectCompressionPolicy::getMinimumSavings (void) const
+	{
+		return mMinimumSavings;
+	}
+	//---------------------------------------------------------------------
+	CompressionSettings ProjectCompressionPolicy::getSettings (const String& nameInZip, const unsigned char* sample, size_t sampleLength) const
+	{
+		CompressionSettings settings;
+		settings.method = (mDefaultLevel != 0) ? Z_DEFLATED : 0;
+		settings.level = mDefaultLevel;
+		settings.strategy = Z_DEFAULT_STRATEGY;
+		if (!mEnabled || settings.method == 0)
+			return settings;
+
+		String extension = nameInZip.substr(nameInZip.find_last_of(".") + 1);
+		Ogre::StringUtil::toLowerCase(extension);
+		if (sampleLength > SAMPLE_SIZE)
+			sampleLength = SAMPLE_SIZE;
+
+		// 1. Already compressed; deflate does not gain anything
+		if (isCompressedFormat(extension, sample, sampleLength))
+		{
+			settings.method = 0;
+			settings.level = 0;
+			return settings;
+		}
+
+		// 2. Hardly any redundancy in the first bytes
+		int savings = getProjectedSavings(sample, sampleLength);
+		if (sampleLength > 0 && savings < mMinimumSavings)
+		{
+			settings.method = 0;
+			settings.level = 0;
+			return settings;
+		}
+
+		// 3. Small text files (material Json, cfg) compress well; use the maximum level
+		if (isText(extension, sample, sampleLength))
+		{
+			settings.level = Z_BEST_COMPRESSION;
+			return settings;
+		}
+
+		// 4. Block compressed textures contain few long matches; only a fast level pays off
+		if (isBlockCompressedTexture(extension, sample, sampleLength))
+		{
+			settings.level = Z_BEST_SPEED;
+			if (savings < HUFFMAN_ONLY_SAVINGS)
+				settings.strategy = Z_HUFFMAN_ONLY;
+			return settings;
+		}
+
+		// 5. Uncompressed images with large areas of the same color
+		if (hasLongRuns(sample, sampleLength))
+			settings.strategy = Z_RLE;
+
+		return settings;
+	}
+	//---------------------------------------------------------------------
+	int ProjectCompressionPolicy::getProjectedSavings (const unsigned char* sample, size_t sampleLength)
+	{
+		// The Shannon entropy (bits per byte) is the lower bound of an order-0 entropy coder
+		if (sampleLength == 0)
+			return 100;
+
+		size_t histogram[256];
+		memset(histogram, 0, sizeof(histogram));
+		for (size_t i = 0; i < sampleLength; ++i)
+			histogram[sample[i]]++;
+
+		double entropy = 0.0;
+		for (int i = 0; i < 256; ++i)
+		{
+			if (histogram[i] > 0)
+			{
+				double p = (double)histogram[i] / (double)sampleLength;
+				entropy -= p * std::log(p) / std::log(2.0);
+			}
+		}
+
+		return (int)((8.0 - entropy) * 100.0 / 8.0);
+	}
+	//---------------------------------------------------------------------
+	bool ProjectCompressionPolicy::isCompressedFormat (const String& extension, const unsigned char* sample, size_t sampleLength) const
+	{
+		static const unsigned char pngSignature[] = { 0x89, 'P', 'N', 'G' };
+		static const unsigned char jpgSignature[] = { 0xFF, 0xD8, 0xFF };
+		static const unsigned char gifSignature[] = { 'G', 'I', 'F', '8' };
+		static const unsigned char zipSignature[] = { 'P', 'K', 0x03, 0x04 };
+		static const unsigned char gzipSignature[] = { 0x1F, 0x8B };
+		if ((sampleLength >= sizeof(pngSignature) && memcmp(sample, pngSignature, sizeof(pngSignature)) == 0) ||
+			(sampleLength >= sizeof(jpgSignature) && memcmp(sample, jpgSignature, sizeof(jpgSignature)) == 0) ||
+			(sampleLength >= sizeof(gifSignature) && memcmp(sample, gifSignature, sizeof(gifSignature)) == 0) ||
+			(sampleLength >= sizeof(zipSignature) && memcmp(sample, zipSignature, sizeof(zipSignature)) == 0) ||
+			(sampleLength >= sizeof(gzipSignature) && memcmp(sample, gzipSignature, sizeof(gzipSignature)) == 0))
+			return true;
+
+		// Files without a recognizable header
+		return extension == "png" ||
+			extension == "jpg" ||
+			extension == "jpeg" ||
+			extension == "gif" ||
+			extension == "zip" ||
+			extension == "gz";
+	}
+	//---------------------------------------------------------------------
+	bool ProjectCompressionPolicy::isBlockCompressedTexture (const String& extension, const unsigned char* sample, size_t sampleLength) const
+	{
+		// Dds: 'DDS ' magic, followed by the header; the pixel format fourCC is at offset 84
+		static const unsigned char ddsSignature[] = { 'D', 'D', 'S', ' ' };
+		if (sampleLength >= 88 && memcmp(sample, ddsSignature, sizeof(ddsSignature)) == 0)
+		{
+			const char* fourCC = (const char*)sample + 84;
+			if (memcmp(fourCC, "DXT", 3) == 0 ||
+				memcmp(fourCC, "ATI", 3) == 0 ||
+				memcmp(fourCC, "BC4", 3) == 0 ||
+				memcmp(fourCC, "BC5", 3) == 0)
+				return true;
+
+			// DX10 header (offset 128); dxgi formats 70 to 84 and 94 to 99 are BC1 to BC7
+			if (memcmp(fourCC, "DX10", 4) == 0 && sampleLength >= 132)
+			{
+				unsigned int dxgiFormat = sample[128] | (sample[129] << 8) | (sample[130] << 16) | ((unsigned int)sample[131] << 24);
+				return (dxgiFormat >= 70 && dxgiFormat <= 84) || (dxgiFormat >= 94 && dxgiFormat <= 99);
+			}
+			return false;
+		}
+
+		// Ktx: '«KTX 11»' magic; glType 0 means a compressed internal format
+		static const unsigned char ktxSignature[] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB };
+		if (sampleLength >= 20 && memcmp(sample, ktxSignature, sizeof(ktxSignature)) == 0)
+			return sample[16] == 0 && sample[17] == 0 && sample[18] == 0 && sample[19] == 0;
+
+		return extension == "ktx" || extension == "pvr" || extension == "astc";
+	}
+	//---------------------------------------------------------------------
+	bool ProjectCompressionPolicy::isText (const String& extension, const unsigned char* sample, size_t sampleLength) const
+	{
+		if (extension == "json" || extension == "cfg" || extension == "txt" || extension == "material")
+			return true;
+
+		for (size_t i = 0; i < sampleLength; ++i)
+		{
+			if (sample[i] < 0x09 || (sample[i] > 0x0D && sample[i] < 0x20))
+				return false;
+		}
+		return sampleLength > 0;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectCompressionPolicy::hasLongRuns (const unsigned char* sample, size_t sampleLength) const
+	{
+		if (sampleLength < 2)
+			return false;
+
+		size_t equal = 0;
+		for (size_t i = 1; i < sampleLength; ++i)
+		{
+			if (sample[i] == sample[i - 1])
+				++equal;
+		}
+		return equal * 100 > (sampleLength - 1) * RUN_PERCENTAGE;
+	}
+}
@@ -0,0 +1,290 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+#include "ProjectFileCopy.h"
+#include "ProjectJob.h"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#else
+#	include <sys/types.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <cerrno>
+#	include <cstring>
+#	if defined(__linux__)
+#		include <sys/ioctl.h>
+#		include <sys/sendfile.h>
+#		include <sys/syscall.h>
+#		include <linux/fs.h>
+#	endif
+#endif
+
+namespace Ogre
+{
+	// The in-kernel copies are done per chunk, so a cancelled job stops within one chunk
+	static const size_t COPY_CHUNK_SIZE = 64 * 1024 * 1024;
+	static const size_t COPY_BUFFER_SIZE = 1024 * 1024;
+	static const size_t COPY_BUFFER_ALIGNMENT = 4096;
+
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+	//---------------------------------------------------------------------
+	static DWORD CALLBACK copyProgressRoutine (LARGE_INTEGER totalFileSize,
+		LARGE_INTEGER totalBytesTransferred,
+		LARGE_INTEGER streamSize,
+		LARGE_INTEGER streamBytesTransferred,
+		DWORD streamNumber,
+		DWORD callbackReason,
+		HANDLE sourceFile,
+		HANDLE destinationFile,
+		LPVOID data)
+	{
+		const ProjectJobProgress* progress = (const ProjectJobProgress*)data;
+		return (progress && progress->isCancelled()) ? PROGRESS_CANCEL : PROGRESS_CONTINUE;
+	}
+#else
+	enum CopyState
+	{
+		COPY_DONE,
+		COPY_UNSUPPORTED, // Continue with the next method
+		COPY_FAILED, // errno describes the error
+		COPY_CANCELLED
+	};
+
+	//---------------------------------------------------------------------
+	static bool isUnsupported (int error)
+	{
+		return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP || error == ENOTTY;
+	}
+	//---------------------------------------------------------------------
+	static CopyState copyClone (int source, int destination)
+	{
+#	if defined(__linux__) && defined(FICLONE)
+		if (ioctl(destination, FICLONE, source) == 0)
+			return COPY_DONE;
+#	endif
+		return COPY_UNSUPPORTED;
+	}
+	//---------------------------------------------------------------------
+	static CopyState copyFileRange (int source, int destination, uint64 size, uint64* offset, const ProjectJobProgress* progress)
+	{
+#	if defined(__linux__) && defined(__NR_copy_file_range)
+		while (*offset < size)
+		{
+			if (progress && progress->isCancelled())
+				return COPY_CANCELLED;
+
+			loff_t offsetSource = (loff_t)*offset;
+			loff_t offsetDestination = (loff_t)*offset;
+			size_t length = (size_t)std::min((uint64)COPY_CHUNK_SIZE, size - *offset);
+			ssize_t copied = syscall(__NR_copy_file_range, source, &offsetSource, destination, &offsetDestination, length, 0);
+			if (copied < 0 && errno == EINTR)
+				continue;
+			if (copied < 0)
+				return isUnsupported(errno) ? COPY_UNSUPPORTED : COPY_FAILED;
+			if (copied == 0)
+				return COPY_UNSUPPORTED; // Some file systems report nothing instead of an error
+			*offset += (uint64)copied;
+		}
+		return COPY_DONE;
+#	else
+		return COPY_UNSUPPORTED;
+#	endif
+	}
+	//---------------------------------------------------------------------
+	static CopyState copySendfile (int source, int destination, uint64 size, uint64* offset, const ProjectJobProgress* progress)
+	{
+#	if defined(__linux__)
+		// sendfile writes at the file position of the destination
+		if (lseek(destination, (off_t)*offset, SEEK_SET) < 0)
+			return COPY_UNSUPPORTED;
+
+		while (*offset < size)
+		{
+			if (progress && progress->isCancelled())
+				return COPY_CANCELLED;
+
+			off_t offsetSource = (off_t)*offset;
+			size_t length = (size_t)std::min((uint64)COPY_CHUNK_SIZE, size - *offset);
+			ssize_t copied = sendfile(destination, source, &offsetSource, length);
+			if (copied < 0 && errno == EINTR)
+				continue;
+			if (copied < 0)
+				return isUnsupported(errno) ? COPY_UNSUPPORTED : COPY_FAILED;
+			if (copied == 0)
+				return COPY_UNSUPPORTED;
+			*offset += (uint64)copied;
+		}
+		return COPY_DONE;
+#	else
+		return COPY_UNSUPPORTED;
+#	endif
+	}
+	//---------------------------------------------------------------------
+	static CopyState copyBuffered (int source, int destination, uint64 size, uint64* offset, const ProjectJobProgress* progress)
+	{
+		std::vector<char> buffer(COPY_BUFFER_SIZE + COPY_BUFFER_ALIGNMENT);
+		char* aligned = &buffer[0] + (COPY_BUFFER_ALIGNMENT - (size_t)&buffer[0] % COPY_BUFFER_ALIGNMENT) % COPY_BUFFER_ALIGNMENT;
+		while (*offset < size)
+		{
+			if (progress && progress->isCancelled())
+				return COPY_CANCELLED;
+
+			size_t length = (size_t)std::min((uint64)COPY_BUFFER_SIZE, size - *offset);
+			ssize_t sizeRead = pread(source, aligned, length, (off_t)*offset);
+			if (sizeRead < 0 && errno == EINTR)
+				continue;
+			if (sizeRead < 0)
+				return COPY_FAILED;
+			if (sizeRead == 0)
+				break; // The source became smaller while it was copied
+
+			ssize_t sizeWritten = 0;
+			while (sizeWritten < sizeRead)
+			{
+				ssize_t written = pwrite(destination, aligned + sizeWritten, (size_t)(sizeRead - sizeWritten), (off_t)(*offset + sizeWritten));
+				if (written < 0 && errno == EINTR)
+					continue;
+				if (written <= 0)
+					return COPY_FAILED;
+				sizeWritten += written;
+			}
+			*offset += (uint64)sizeRead;
+		}
+		return COPY_DONE;
+	}
+#endif
+
+	//---------------------------------------------------------------------
+	ProjectFileCopy::ProjectFileCopy (void) :
+		mMethod(METHOD_NONE)
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectFileCopy::~ProjectFileCopy (void)
+	{
+	}
+	//---------------------------------------------------------------------
+	bool ProjectFileCopy::copy (const String& fileNameSource, const String& fileNameDestination, const ProjectJobProgress* progress)
+	{
+		mMethod = METHOD_NONE;
+		mErrorText = "";
+
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+		// CopyFileEx removes the destination file itself if the copy is cancelled
+		mMethod = METHOD_COPY_FILE_EX;
+		if (CopyFileExA(fileNameSource.c_str(), fileNameDestination.c_str(), copyProgressRoutine, (LPVOID)progress, NULL, 0))
+			return true;
+
+		DWORD error = GetLastError();
+		if (error == ERROR_REQUEST_ABORTED)
+			return setError("Copying " + fileNameSource + " was cancelled");
+		std::remove(fileNameDestination.c_str());
+		std::ostringstream errorText;
+		errorText << "Could not copy " << fileNameSource << " to " << fileNameDestination << " (error " << error << ")";
+		return setError(errorText.str());
+#else
+		int source = open(fileNameSource.c_str(), O_RDONLY);
+		if (source < 0)
+			return setError("Could not open " + fileNameSource + ": " + strerror(errno));
+
+		struct stat status;
+		if (fstat(source, &status) != 0)
+		{
+			String errorText = "Could not read the size of " + fileNameSource + ": " + strerror(errno);
+			::close(source);
+			return setError(errorText);
+		}
+
+		int destination = open(fileNameDestination.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+		if (destination < 0)
+		{
+			String errorText = "Could not create " + fileNameDestination + ": " + strerror(errno);
+			::close(source);
+			return setError(errorText);
+		}
+
+		// Each method continues at the offset where the previous one stopped; a reflink only applies to the whole file
+		uint64 size = (uint64)status.st_size;
+		uint64 offset = 0;
+		mMethod = METHOD_CLONE;
+		CopyState state = copyClone(source, destination);
+		if (state == COPY_UNSUPPORTED)
+		{
+			mMethod = METHOD_COPY_FILE_RANGE;
+			state = copyFileRange(source, destination, size, &offset, progress);
+		}
+		if (state == COPY_UNSUPPORTED)
+		{
+			mMethod = METHOD_SENDFILE;
+			state = copySendfile(source, destination, size, &offset, progress);
+		}
+		if (state == COPY_UNSUPPORTED)
+		{
+			mMethod = METHOD_BUFFERED;
+			state = copyBuffered(source, destination, size, &offset, progress);
+		}
+
+		int error = (state == COPY_FAILED) ? errno : 0;
+		::close(source);
+		if (::close(destination) != 0 && state == COPY_DONE)
+		{
+			error = errno;
+			state = COPY_FAILED;
+		}
+		if (state == COPY_DONE)
+			return true;
+
+		std::remove(fileNameDestination.c_str());
+		if (state == COPY_CANCELLED)
+			return setError("Copying " + fileNameSource + " was cancelled");
+		return setError("Could not copy " + fileNameSource + " to " + fileNameDestination + ": " + strerror(error));
+#endif
+	}
+	//---------------------------------------------------------------------
+	ProjectFileCopy::Method ProjectFileCopy::getMethod (void) const
+	{
+		return mMethod;
+	}
+	//---------------------------------------------------------------------
+	const String& ProjectFileCopy::getErrorText (void) const
+	{
+		return mErrorText;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectFileCopy::setError (const String& errorText)
+	{
+		mErrorText = errorText;
+		return false;
+	}
+}
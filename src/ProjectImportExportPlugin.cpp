@@ -27,40 +27,37 @@ Copyright (c) 2000-2014 Torus Knot Software Ltd
 */
 
 #include "OgreRoot.h"
+#include "OgreArchiveManager.h"
 #include "ProjectImportExportPlugin.h"
 #include "OgreHlmsPbs.h"
 #include "OgreHlmsPbsDatablock.h"
 #include "OgreHlmsUnlit.h"
 #include "OgreHlmsUnlitDatablock.h"
-#include "OgreHlmsJson.h"
 #include "OgreHlmsManager.h"
 #include "OgreLogManager.h"
 #include "OgreItem.h"
-#include "zip.h"
-#include "unzip.h"
-#include <iostream>
+#include "ProjectFileCopy.h"
+#include "ProjectMaterialScanner.h"
+#include "ProjectZipWriter.h"
+#include <algorithm>
+#include <atomic>
+#include <sstream>
 #include <fstream>
 
 namespace Ogre
 {
-	#ifdef __APPLE__
-		// In darwin and perhaps other BSD variants off_t is a 64 bit value, hence no need for specific 64 bit functions
-		#define FOPEN_FUNC(filename, mode) fopen(filename, mode)
-		#define FTELLO_FUNC(stream) ftello(stream)
-		#define FSEEKO_FUNC(stream, offset, origin) fseeko(stream, offset, origin)
-	#else
-		#define FOPEN_FUNC(filename, mode) fopen64(filename, mode)
-		#define FTELLO_FUNC(stream) ftello64(stream)
-		#define FSEEKO_FUNC(stream, offset, origin) fseeko64(stream, offset, origin)
-	#endif
-
-	#define WRITEBUFFERSIZE (262144)
-	#define MAX_FILENAME 512
-	#define READ_SIZE 32768
-
 	static const String gImportMenuText = "Import HLMS Editor project";
 	static const String gExportMenuText = "Export current HLMS Editor project";
-	static String gTempString = "";
+
+	//---------------------------------------------------------------------
+	static bool isCfgFileForImport (const String& nameInZip)
+	{
+		// These files are rewritten from memory during the import, so they are not extracted
+		return nameInZip == "project.txt" ||
+			nameInZip == "materials.cfg" ||
+			nameInZip == "textures.cfg" ||
+			nameInZip == "meshes.cfg";
+	}
 	//---------------------------------------------------------------------
 	ProjectImportExportPlugin::ProjectImportExportPlugin()
 	{
@@ -74,6 +71,8 @@ namespace Ogre
 	//---------------------------------------------------------------------
 	void ProjectImportExportPlugin::install()
 	{
+		// Zip files of imported projects can be used as resource location
+		ArchiveManager::getSingleton().addArchiveFactory(&mArchiveFactory);
 	}
 	//---------------------------------------------------------------------
 	void ProjectImportExportPlugin::initialise()
@@ -83,7 +82,12 @@ namespace Ogre
 	//---------------------------------------------------------------------
 	void ProjectImportExportPlugin::shutdown()
 	{
-		// nothing to do
+		// Do not leave a job running in the background
+		if (mJob.isRunning())
+		{
+			mJob.cancel();
+			mJob.wait();
+		}
 	}
 	//---------------------------------------------------------------------
 	void ProjectImportExportPlugin::uninstall()
@@ -117,20 +121,7 @@ namespace Ogre
 	//---------------------------------------------------------------------
 	void ProjectImportExportPlugin::performPostExportActions(void)
 	{
-		// Delete the copied files
-		// Note: Deleting the files as part of the export and just after creating a zip file
-		// results in a corrupted zip file. Apparently, the files are still in use, even if the zip file
-		// is already closed
-		mySleep(1);
-		std::vector<String>::iterator it = mFileNamesDestination.begin();
-		std::vector<String>::iterator itEnd = mFileNamesDestination.end();
-		String fileName;
-		while (it != itEnd)
-		{
-			fileName = *it;
-			std::remove(fileName.c_str());
-			++it;
-		}
+		// Nothing to do; the source files are streamed directly into the zip file, so there are no copies to delete
 	}
 	//---------------------------------------------------------------------
 	unsigned int ProjectImportExportPlugin::getActionFlag(void)
@@ -165,6 +156,68 @@ namespace Ogre
 		property.boolValue = false;
 		mProperties[property.propertyName] = property;
 
+		// Staging copy of the imported zip file
+		property.propertyName = "import_staging_copy";
+		property.labelName = "Copy the project file before importing";
+		property.info = "If this property is set to 'true' the selected zip file is first copied to the import directory and\n"
+			"extracted from there; use this for zip files on removable media. Otherwise it is extracted in place.\n";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = false;
+		mProperties[property.propertyName] = property;
+
+		// Mount the imported zip file
+		property.propertyName = "import_mount_archive";
+		property.labelName = "Load the textures from the project file";
+		property.info = "If this property is set to 'true' the textures are not extracted; the zip file is added to the resources\n"
+			"and Ogre reads a texture from it when the texture is used. The zip file (or its staging copy) must stay in place.\n";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = false;
+		mProperties[property.propertyName] = property;
+
+		// Parallel import
+		property.propertyName = "import_parallel";
+		property.labelName = "Extract the project files in parallel";
+		property.info = "If this property is set to 'true' the files of the imported zip file are extracted by multiple threads.\n";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = true;
+		mProperties[property.propertyName] = property;
+
+		// Compression per file
+		property.propertyName = "compression_policy";
+		property.labelName = "Choose the compression per file";
+		property.info = "If this property is set to 'true' the compression of each file depends on its type and content.\n"
+			"Already compressed files (png, jpg) are stored, compressed textures (dds, ktx) use fast compression\n"
+			"and material files use maximum compression.\n";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = true;
+		mProperties[property.propertyName] = property;
+
+		// Incremental export
+		property.propertyName = "incremental_export";
+		property.labelName = "Reuse unchanged files of a previous export";
+		property.info = "If this property is set to 'true' and the zip file already exists, the unchanged files\n"
+			"(same size, modification time and crc) are copied from the existing zip file without compressing them again.\n";
+		property.type = HlmsEditorPluginData::BOOL;
+		property.boolValue = true;
+		mProperties[property.propertyName] = property;
+
+		// Default compression level
+		property.propertyName = "compression_level";
+		property.labelName = "Compression level (0 - 9)";
+		property.info = "Compression level of files that do not need a specific compression; 0 means no compression.\n";
+		property.type = HlmsEditorPluginData::INT;
+		property.intValue = 6;
+		mProperties[property.propertyName] = property;
+
+		// Minimal projected savings
+		property.propertyName = "compression_min_savings";
+		property.labelName = "Minimal projected savings (%)";
+		property.info = "Files with a projected size reduction below this percentage are stored without compression.\n"
+			"The projection is based on the entropy of the first bytes of the file.\n";
+		property.type = HlmsEditorPluginData::INT;
+		property.intValue = 3;
+		mProperties[property.propertyName] = property;
+
 		return mProperties;
 	}
 	//---------------------------------------------------------------------
@@ -180,67 +233,193 @@ namespace Ogre
 	//---------------------------------------------------------------------
 	bool ProjectImportExportPlugin::executeImport(HlmsEditorPluginData* data)
 	{
-		// As a result of the flag PAF_PRE_IMPORT_MK_DIR, the editor is triggered to create a subdir (in a platform independant way)
+		if (!startImport(data, JobCallback()))
+			return false;
 
-		// Error in case no materials available
-		if (data->mInFileDialogName.empty())
+		return mJob.wait();
+	}
+	//---------------------------------------------------------------------
+	bool ProjectImportExportPlugin::executeExport (HlmsEditorPluginData* data)
+	{
+		if (!startExport(data, JobCallback()))
+			return false;
+
+		return mJob.wait();
+	}
+	//---------------------------------------------------------------------
+	bool ProjectImportExportPlugin::startImport (HlmsEditorPluginData* data, const JobCallback& callback)
+	{
+		if (mJob.isRunning())
 		{
-			data->mOutErrorText = "No import file selected";
+			data->mOutErrorText = "An import or export is still running";
 			return false;
 		}
 
-		// Determine the destination path where the project files are copied; this is a newly created dir, based on the import (zip) file
-		mProjectPath = data->mInImportPath + data->mInFileDialogBaseName + "/";
+		mJobData = *data;
+		return mJob.start([this]() { return importProject(&mJobData); },
+			[this, data, callback](bool success)
+			{
+				if (success)
+				{
+					// 8. Add the subdir - containing the upzipped project files - to the Ogre resources (and update resources.cfg)
+					// Note, that mProjectPath cannot be used, because it contains a trailing '/'
+					// The flag PAF_POST_IMPORT_SAVE_RESOURCE_LOCATIONS triggers the editor to perform the save action (which is already implemented by the editor)
+					// This is done on the thread that completes the job, because Ogre is not used by the background thread
+					Root* root = Root::getSingletonPtr();
+					root->addResourceLocation(data->mInImportPath + data->mInFileDialogBaseName, "FileSystem", "General");
+					if (!mMountedZip.empty())
+						root->addResourceLocation(mMountedZip, ProjectArchiveFactory::ARCHIVE_TYPE, "General");
+				}
 
-		// 1. Copy the zipfile to the target path
-		String sourceZip = data->mInExportPath + data->mInFileDialogName;
-		String baseName = sourceZip.substr(sourceZip.find_last_of("/\\") + 1);
-		String destinationZip = mProjectPath + baseName;
-		copyFile(sourceZip, destinationZip);
-
-		// 1. Validate the selected project export file
-		char zipFile[1024];
-		memset(zipFile, 0, sizeof(char)*1024);
-		strcpy(zipFile, destinationZip.c_str());
-		if (!validateZip(zipFile, data))
+				data->mOutSuccessText = mJobData.mOutSuccessText;
+				data->mOutErrorText = mJobData.mOutErrorText;
+				data->mOutReference = mJobData.mOutReference;
+				if (callback)
+					callback(success, data);
+			});
+	}
+	//---------------------------------------------------------------------
+	bool ProjectImportExportPlugin::startExport (HlmsEditorPluginData* data, const JobCallback& callback)
+	{
+		if (mJob.isRunning())
+		{
+			data->mOutErrorText = "An import or export is still running";
 			return false;
+		}
 
-		// 2. Unzip the selected file to the created subdir (mProjectPath)
-		if (!unzip(zipFile, data))
-			return false;
+		// The Ogre resources are only used here, by the calling thread
+		mTextureResolver.build(data->mInTextureFileNameVector);
 
-		// 3 Remove the zip file, because it is not used anymore
-		std::remove(destinationZip.c_str());
+		mJobData = *data;
+		return mJob.start([this]() { return exportProject(&mJobData); },
+			[this, data, callback](bool success)
+			{
+				data->mOutSuccessText = mJobData.mOutSuccessText;
+				data->mOutErrorText = mJobData.mOutErrorText;
+				if (callback)
+					callback(success, data);
+			});
+	}
+	//---------------------------------------------------------------------
+	bool ProjectImportExportPlugin::pollJob (void)
+	{
+		return mJob.poll();
+	}
+	//---------------------------------------------------------------------
+	void ProjectImportExportPlugin::cancelJob (void)
+	{
+		mJob.cancel();
+	}
+	//---------------------------------------------------------------------
+	bool ProjectImportExportPlugin::isJobRunning (void) const
+	{
+		return mJob.isRunning();
+	}
+	//---------------------------------------------------------------------
+	const ProjectJobProgress& ProjectImportExportPlugin::getJobProgress (void) const
+	{
+		return mJob.getProgress();
+	}
+	//---------------------------------------------------------------------
+	bool ProjectImportExportPlugin::importProject (HlmsEditorPluginData* data)
+	{
+		// As a result of the flag PAF_PRE_IMPORT_MK_DIR, the editor is triggered to create a subdir (in a platform independant way)
 
-		// 4. Create the project file (.hlmp) with the references to the material- and texture cfg files
-		if (!createProjectFileForImport(data))
+		// Error in case no materials available
+		if (data->mInFileDialogName.empty())
 		{
-			data->mOutErrorText = "Could not create project file";
+			data->mOutErrorText = "No import file selected";
 			return false;
 		}
 
-		// 5. Re-create the material cfg file with the mProjectPath
-		if (!createMaterialCfgFileForImport(data))
+		prepareImport(data);
+
+		// 1. The zip file is read in place (read-only); only copy it to the target path if a staging copy is requested,
+		// for example because the zip file is on removable media
+		String sourceZip = data->mInExportPath + data->mInFileDialogName;
+		String zipName = sourceZip;
+		String destinationZip;
+		std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY>::iterator itProperties = data->mInPropertiesMap.find("import_staging_copy");
+		if (itProperties != data->mInPropertiesMap.end() && (itProperties->second).boolValue)
 		{
-			data->mOutErrorText = "Could not create materials file";
-			return false;
+			String baseName = sourceZip.substr(sourceZip.find_last_of("/\\") + 1);
+			destinationZip = mProjectPath + baseName;
+			String errorText;
+			if (!copyFile(sourceZip, destinationZip, &errorText))
+			{
+				if (mJob.getProgress().isCancelled())
+					data->mOutErrorText = "Import cancelled";
+				else
+					data->mOutErrorText = "Could not copy the import file to " + mProjectPath + ": " + errorText;
+				return false;
+			}
+			zipName = destinationZip;
 		}
 
-		// 6. Re-create the texture cfg file with the mProjectPath
-		if (!createTextureCfgFileForImport(data))
+		// 1. Validate the selected project export file; the central directory is read once and used for both
+		// the validation and the extraction
+		ProjectZipReader zipReader;
+		if (!zipReader.open(zipName) || !validateZip(zipReader, data))
 		{
-			data->mOutErrorText = "Could not create textures file";
+			if (data->mOutErrorText.empty())
+				data->mOutErrorText = zipReader.getErrorText();
+			zipReader.close();
+			if (!destinationZip.empty())
+				std::remove(destinationZip.c_str());
 			return false;
 		}
 
-		// 7. Re-create the meshes cfg file with the mProjectPath if the file exists
-		createMeshesCfgFileForImport(data);
+		// 2. Unzip the selected file to the created subdir (mProjectPath). The thumbs of the materials are extracted
+		// to ../common/thumbs directly. If the zip file is mounted as archive, the textures are not extracted; Ogre reads
+		// them from the zip file when they are used
+		bool mount = false;
+		itProperties = data->mInPropertiesMap.find("import_mount_archive");
+		if (itProperties != data->mInPropertiesMap.end())
+			mount = (itProperties->second).boolValue;
+		ProjectNameIndex textureNames;
+		ProjectNameIndex thumbNames;
+		bool unzipped;
+		if (!readThumbNamesFromZip(zipReader, &thumbNames) ||
+			(mount && !readTextureNamesFromZip(zipReader, &textureNames)))
+		{
+			data->mOutErrorText = zipReader.getErrorText();
+			unzipped = false;
+		}
+		else
+			unzipped = unzip(zipReader, data, mount ? &textureNames : NULL, &thumbNames);
+
+		// The textures of a mounted zip file are referred to in the zip file (see createTextureCfgFileForImport)
+		if (mount)
+			mMountedZip = zipName;
+
+		// 3. - 7. The project file and the cfg files are not extracted; they are read from the zip file into memory,
+		// and only the files with the mProjectPath are written
+		bool created = false;
+		if (!unzipped)
+			; // The error is already set
+		else if (!createProjectFileForImport(zipReader, data))
+			data->mOutErrorText = "Could not create project file"; // 4. The project file (.hlmp) with the references to the cfg files
+		else if (!createMaterialCfgFileForImport(zipReader, data))
+			data->mOutErrorText = "Could not create materials file"; // 5. The material cfg file with the mProjectPath
+		else if (!createTextureCfgFileForImport(zipReader, data))
+			data->mOutErrorText = "Could not create textures file"; // 6. The texture cfg file with the mProjectPath
+		else
+		{
+			// 7. The meshes cfg file with the mProjectPath if the file exists
+			createMeshesCfgFileForImport(zipReader, data);
+			created = true;
+		}
+		zipReader.close();
+
+		// Remove the staging copy of the zip file, because it is not used anymore (unless it is mounted)
+		if (!created)
+			mMountedZip = "";
+		if (mMountedZip.empty() && !destinationZip.empty())
+			std::remove(destinationZip.c_str());
+		if (!created)
+			return false;
 
-		// 8. Add the subdir - containing the upzipped project files - to the Ogre resources (and update resources.cfg)
-		// Note, that mProjectPath cannot be used, because it contains a trailing '/'
-		// The flag PAF_POST_IMPORT_SAVE_RESOURCE_LOCATIONS triggers the editor to perform the save action (which is already implemented by the editor)
-		Root* root = Root::getSingletonPtr();
-		root->addResourceLocation(data->mInImportPath + data->mInFileDialogBaseName, "FileSystem", "General");
+		// 8. Adding the subdir to the Ogre resources is done when the job completes (see startImport)
 
 		// 9. Open the .hlmp project file (must be done by the editor)
 		// he flag PAF_POST_IMPORT_OPEN_PROJECT triggers the editor to perform the 'load project' action
@@ -249,18 +428,34 @@ namespace Ogre
 		return true;
 	}
 	//---------------------------------------------------------------------
-	bool ProjectImportExportPlugin::executeExport (HlmsEditorPluginData* data)
+	void ProjectImportExportPlugin::prepareImport (HlmsEditorPluginData* data)
+	{
+		// Determine the destination path where the project files are copied; this is a newly created dir, based on the import (zip) file
+		mProjectPath = data->mInImportPath + data->mInFileDialogBaseName + "/";
+		mMountedZip = "";
+	}
+	//---------------------------------------------------------------------
+	const String& ProjectImportExportPlugin::getProjectPath (void) const
+	{
+		return mProjectPath;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectImportExportPlugin::exportProject (HlmsEditorPluginData* data)
 	{
-		mFileNamesDestination.clear();
+		mExportEntries.clear();
+		mTextureEntries.clear();
 		mUniqueTextureFiles.clear();
 
 		// Do not quit when data->mInTexturesUsedByDatablocks and/or data->mInMaterialFileNameVector is empty!!
 
-		// 1. Copy texture files from the material (Json) files
+		// 1. Collect texture files from the material (Json) files
 		// This is needed in case the texture is not available in the texture browser; the exported zip file
 		// contains both the images/textures from the texture browser and the references in the material/json files
 
-		// Iterate through the json files of the material browser and load them into Ogre
+		// Iterate through the json files of the material browser and scan them for texture references; the
+		// materials are not loaded into the HlmsManager, so the export does not create or change datablocks
+		ProjectMaterialScanner materialScanner;
+		std::vector<String> materialTextureNames;
 		std::vector<String> materials;
 		materials = data->mInMaterialFileNameVector;
 		std::vector<String>::iterator it;
@@ -269,7 +464,7 @@ namespace Ogre
 		String fileName;
 		for (it = itStart; it != itEnd; ++it)
 		{
-			// Load the materials
+			// Scan the materials
 			fileName = *it;
 			if (fileName.empty())
 			{
@@ -277,18 +472,24 @@ namespace Ogre
 				return false;
 			}
 
-			// If an Exception is thrown, it may be because the loaded material is already available; just ignore it
-			if (!loadMaterial(fileName))
-			{
-				data->mOutErrorText = "Error while processing the materials";
-				return false;
-			}
+			// A material that cannot be scanned is still exported; only its textures may be missing
+			if (!materialScanner.scanFile(fileName, materialTextureNames))
+				LogManager::getSingleton().logMessage("ProjectImportExportPlugin: " + materialScanner.getErrorText());
 		}
 
-		// Retrieve all the texturenames from the loaded datablocks
-		std::vector<String> v = data->mInTexturesUsedByDatablocks;
+		// Combine the texturenames used by the datablocks with the ones referenced by the material files
+		std::vector<String> v;
+		ProjectNameIndex textureNames;
+		std::vector<String>::iterator itTextureNames;
+		for (itTextureNames = data->mInTexturesUsedByDatablocks.begin(); itTextureNames != data->mInTexturesUsedByDatablocks.end(); ++itTextureNames)
+			if (textureNames.add(*itTextureNames))
+				v.push_back(*itTextureNames);
+		for (itTextureNames = materialTextureNames.begin(); itTextureNames != materialTextureNames.end(); ++itTextureNames)
+			if (textureNames.add(*itTextureNames))
+				v.push_back(*itTextureNames);
 
 		// vector v only contains basenames; Get the full qualified name instead
+		// The resources and the texture list are indexed once (when the export is started), instead of searched for each texture
 		std::vector<String>::iterator itBaseNames;
 		std::vector<String>::iterator itBaseNamesStart = v.begin();
 		std::vector<String>::iterator itBaseNamesEnd = v.end();
@@ -299,11 +500,11 @@ namespace Ogre
 			baseName = *itBaseNames;
 
 			// Search in the Ogre resources
-			fileName = getFullFileNameFromResources(baseName, data);
+			fileName = mTextureResolver.getFullFileNameFromResources(baseName);
 			if (fileName.empty())
 			{
 				// It cannot be found in the resources, try it in the texture list from the project
-				fileName = getFullFileNameFromTextureList(baseName, data);
+				fileName = mTextureResolver.getFullFileNameFromTextureList(baseName);
 			}
 
 			if (!fileName.empty())
@@ -313,50 +514,37 @@ namespace Ogre
 			}
 		}
 
-		// Copy all textures to the export dir
+		// Add all textures to the export; they are streamed directly from their source location into the zip file
 		std::vector<String>::iterator itFileNamesSource;
 		std::vector<String>::iterator itFileNamesSourceStart = fileNamesSource.begin();
 		std::vector<String>::iterator itFileNamesSourceEnd = fileNamesSource.end();
 		String fileNameSource;
-		String fileNameDestination;
 		for (itFileNamesSource = itFileNamesSourceStart; itFileNamesSource != itFileNamesSourceEnd; ++itFileNamesSource)
 		{
 			fileNameSource = *itFileNamesSource;
 			baseName = fileNameSource.substr(fileNameSource.find_last_of("/\\") + 1);
-			fileNameDestination = data->mInExportPath + baseName;
-			if (!isDestinationFileAvailableInVector(fileNameDestination))
-			{
-				mFileNamesDestination.push_back(fileNameDestination); // Only push unique names
-				mUniqueTextureFiles.push_back(baseName);
-			}
-			copyFile(fileNameSource, fileNameDestination);
+			if (addTextureToExport(fileNameSource, baseName))
+				mUniqueTextureFiles.add(baseName); // Only add unique names
 		}
 
-		// 2. Copy texture files from the texture browser
+		// 2. Collect texture files from the texture browser
 		std::vector<String>::iterator itTextures;
 		std::vector<String>::iterator itTexturesStart = data->mInTextureFileNameVector.begin();
 		std::vector<String>::iterator itTexturesEnd = data->mInTextureFileNameVector.end();
 		String fileNameTextureSource;
-		String fileNameTextureDestination;
 		String baseNameTexture;
 		for (itTextures = itTexturesStart; itTextures != itTexturesEnd; ++itTextures)
 		{
 			fileNameTextureSource = *itTextures;
 			baseNameTexture = fileNameTextureSource.substr(fileNameTextureSource.find_last_of("/\\") + 1);
-			fileNameTextureDestination = data->mInExportPath + baseNameTexture;
-			if (!isDestinationFileAvailableInVector(fileNameTextureDestination))
-			{
-				mFileNamesDestination.push_back(fileNameTextureDestination); // Only push unique names
-				mUniqueTextureFiles.push_back(baseNameTexture);
-			}
-			copyFile(fileNameTextureSource, fileNameTextureDestination);
+			if (addTextureToExport(fileNameTextureSource, baseNameTexture))
+				mUniqueTextureFiles.add(baseNameTexture); // Only add unique names
 		}
 
-		// 3. Copy all Json (material) files
+		// 3. Add all Json (material) files
 		itStart = materials.begin();
 		itEnd = materials.end();
 		String thumbFileNameSource;
-		String thumbFileNameDestination;
 		for (it = itStart; it != itEnd; ++it)
 		{
 			// Load the materials
@@ -367,17 +555,13 @@ namespace Ogre
 				return false;
 			}
 
-			// Copy the json (material) files
+			// Add the json (material) files
 			baseName = fileName.substr(fileName.find_last_of("/\\") + 1);
-			fileNameDestination = data->mInExportPath + baseName;
-			mFileNamesDestination.push_back(fileNameDestination);
-			copyFile(fileName, fileNameDestination);
+			addFileToExport(fileName, baseName);
 
-			// Copy the thumb files
+			// Add the thumb files
 			thumbFileNameSource = "../common/thumbs/" + baseName + ".png";
-			thumbFileNameDestination = data->mInExportPath + baseName + ".png";
-			mFileNamesDestination.push_back(thumbFileNameDestination);
-			copyFile(thumbFileNameSource, thumbFileNameDestination);
+			addFileToExport(thumbFileNameSource, baseName + ".png");
 		}
 
 		// 4. Create project file for export (without paths)
@@ -393,7 +577,7 @@ namespace Ogre
 		// texture cfg file is enriched with the path of the import directory
 		createTextureCfgFileForExport(data);
 
-		// 7. (Optional) copy current meshes to the export
+		// 7. (Optional) add current meshes to the export
 		std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY> properties = data->mInPropertiesMap;
 		std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY>::iterator itProperties = properties.find("include_meshes");
 		String fileNameMesh;
@@ -418,11 +602,9 @@ namespace Ogre
 						fileNameMeshSource = fileNameMesh;
 						if (!fileNameMesh.empty())
 						{
-							// Copy the meshs file(s)
+							// Add the meshs file(s)
 							baseName = fileNameMesh.substr(fileNameMesh.find_last_of("/\\") + 1);
-							fileNameDestination = data->mInExportPath + baseName;
-							mFileNamesDestination.push_back(fileNameDestination);
-							copyFile(fileNameMeshSource, fileNameDestination);
+							addFileToExport(fileNameMeshSource, baseName);
 						}
 					}
 					
@@ -434,431 +616,216 @@ namespace Ogre
 			}
 		}
 
-		// 9. Zip all files
-		zipFile zf;
-		int err;
-		int errclose;
-		const char* password = NULL;
-		void* buf = NULL;
-		int size_buf = 0;
-		size_buf = WRITEBUFFERSIZE;
-		int opt_compress_level = Z_DEFAULT_COMPRESSION;
-		buf = (void*)malloc(WRITEBUFFERSIZE);
-		if (buf == NULL)
-		{
-			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error allocating memory");
-			return false;
-		}
+		// 9. Zip all files; the entries are compressed in parallel, directly from their source (or from memory)
 		String zipName = data->mInExportPath + data->mInProjectName + ".hlmp.zip";
-		char zipFile[1024];
-		memset(zipFile, 0, sizeof(char) * 1024);
-		char filenameInZip[1024];
-		memset(filenameInZip, 0, sizeof(char) * 1024);
-		strcpy(zipFile, zipName.c_str());
-
-//#ifdef USEWIN32IOAPI
-		//zlib_filefunc64_def ffunc;
-		//fill_win32_filefunc64A(&ffunc);
-		//zf = zipOpen2_64(zipFile, 0, NULL, &ffunc);
-//#else
-		//zf = zipOpen(zipFile, 0);
-		zf = zipOpen64(zipFile, 0);
-//#endif
-
-		if (zf == NULL)
-		{
-			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error opening " + String(zipFile));
-		}
-		else
-		{
-			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Creating  " + String(zipFile));
-
-			// Add the copied texture files to the zipfile
-			std::vector<String>::iterator itDest = mFileNamesDestination.begin();
-			std::vector<String>::iterator itDestEnd = mFileNamesDestination.end();
-			while (itDest != itDestEnd)
-			{
-				fileNameDestination = *itDest;
-				strcpy(filenameInZip, fileNameDestination.c_str());
-
-				FILE* fin;
-				int size_read;
-				zip_fileinfo zi;
-				unsigned long crcFile = 0;
-				int zip64 = isLargeFile(filenameInZip);
-				const char *savefilenameInZip;
-				savefilenameInZip = filenameInZip;
-
-				// The path name saved, should not include a leading slash.
-				// If it did, windows/xp and dynazip couldn't read the zip file.
-				while (savefilenameInZip[0] == '\\' || savefilenameInZip[0] == '/')
-				{
-					savefilenameInZip++;
-				}
-
-				// Strip the path
-				const char *tmpptr;
-				const char *lastslash = 0;
-				for (tmpptr = savefilenameInZip; *tmpptr; tmpptr++)
-				{
-					if (*tmpptr == '\\' || *tmpptr == '/')
-					{
-						lastslash = tmpptr;
-					}
-				}
-				if (lastslash != NULL)
-				{
-					savefilenameInZip = lastslash + 1; // base filename follows last slash.
-				}
-
-				err = zipOpenNewFileInZip3_64(zf, savefilenameInZip, &zi,
-					NULL, 0, NULL, 0, NULL /* comment*/,
-					(opt_compress_level != 0) ? Z_DEFLATED : 0,
-					opt_compress_level, 0,
-					/* -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY, */
-					-MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY,
-					password, crcFile, zip64);
-
-				if (err != ZIP_OK)
-				{
-					LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error adding " + String(filenameInZip) + " to zipfile");
-					return false;
-				}
-				else
-				{
-					fin = FOPEN_FUNC(filenameInZip, "rb");
-					if (fin == NULL)
-					{
-						LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error opening " + String(filenameInZip));
-						return false;
-					}
-				}
-
-				if (err == ZIP_OK)
-				{
-					do
-					{
-						err = ZIP_OK;
-						size_read = (int)fread(buf, 1, size_buf, fin);
-						if (size_read < size_buf)
-							if (feof(fin) == 0)
-							{
-								LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error reading " + String(filenameInZip));
-								return false;
-							}
-
-						if (size_read > 0)
-						{
-							err = zipWriteInFileInZip(zf, buf, size_read);
-							if (err < 0)
-							{
-								LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error in writing " + String(filenameInZip) + " in zipfile");
-								return false;
-							}
-
-						}
-					} while ((err == ZIP_OK) && (size_read>0));
-				}
-
-				// Close the file that is added to the zip
-				if (fin)
-					fclose(fin);
-
-				if (err < 0)
-					err = ZIP_ERRNO;
-				else
-				{
-					err = zipCloseFileInZip(zf);
-					if (err != ZIP_OK)
-					{
-						LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error in closing " + String(filenameInZip) + " in zipfile");
-						return false;
-					}
-				}
-
-				// Delete the file from the filesystem
-				//std::remove(filenameInZip);
-
-				// Next file
-				++itDest;
-			}
-		}
-
-		// Close the zipfile
-		errclose = zipClose(zf, NULL);
-		if (errclose != ZIP_OK)
+		ProjectCompressionPolicy policy;
+		itProperties = properties.find("compression_policy");
+		if (itProperties != properties.end())
+			policy.setEnabled((itProperties->second).boolValue);
+		itProperties = properties.find("compression_level");
+		if (itProperties != properties.end())
+			policy.setDefaultLevel(std::max(0, std::min(9, (itProperties->second).intValue)));
+		itProperties = properties.find("compression_min_savings");
+		if (itProperties != properties.end())
+			policy.setMinimumSavings((itProperties->second).intValue);
+		ProjectZipWriter zipWriter;
+		zipWriter.setCompressionPolicy(policy);
+		zipWriter.setProgress(&mJob.getProgress());
+		itProperties = properties.find("incremental_export");
+		if (itProperties != properties.end())
+			zipWriter.setIncremental((itProperties->second).boolValue);
+		if (!zipWriter.write(zipName, mExportEntries))
 		{
-			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error in closing " + String(zipFile));
+			data->mOutErrorText = zipWriter.getErrorText();
 			return false;
 		}
 
-		free(buf);
 		data->mOutSuccessText = "Exported project to " + zipName;
-
-		// Remark: Deleting the copied files here results in a corrupted zip file, so put that as a separate post-export action
-
 		return true;
 	}
 
 	//---------------------------------------------------------------------
-	bool ProjectImportExportPlugin::loadMaterial(const String& fileName)
+	void ProjectImportExportPlugin::addFileToExport (const String& fileNameSource, const String& nameInZip)
 	{
-		// Read the json file as text file and feed it to the HlmsManager::loadMaterials() function
-		// Note, that the resources (textures, etc.) must be present (in resource loacation)
-
-		Root* root = Root::getSingletonPtr();
-		HlmsManager* hlmsManager = root->getHlmsManager();
-		HlmsJson hlmsJson(hlmsManager, 0);
-
-		// Read the content of the file into a string/char*
-		std::ifstream inFile;
-		inFile.open(fileName);
-
-		std::stringstream strStream;
-		strStream << inFile.rdbuf();
-		String jsonAsString = strStream.str();
-
-		std::cout << jsonAsString << std::endl;
-		inFile.close();
-		const char* jsonAsChar = jsonAsString.c_str();
-
-		try
-		{
-			// Load the datablocks (which also creates them)
-			hlmsJson.loadMaterials(fileName, 
-				Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME, 
-				jsonAsChar,
-				""); // The fileName is only used for logging and has no purpose
-		}
-
-		// If an Exception is thrown, it may be because the loaded material is already available; just ignore it
-		catch (Exception e) {}
-
-		return true;
+		ExportEntry entry;
+		entry.nameInZip = nameInZip;
+		entry.fileNameSource = fileNameSource;
+		entry.inMemory = false;
+		entry.archiveFile = mTextureResolver.getArchiveFile(fileNameSource); // For example a texture of a mounted import
+		mExportEntries.push_back(entry);
 	}
 
 	//---------------------------------------------------------------------
-	const String& ProjectImportExportPlugin::getFullFileNameFromTextureList(const String& baseName, HlmsEditorPluginData* data)
+	void ProjectImportExportPlugin::addContentToExport (const String& content, const String& nameInZip)
 	{
-		gTempString = "";
-		std::vector<String>::iterator it;
-		std::vector<String>::iterator itStart = data->mInTextureFileNameVector.begin();
-		std::vector<String>::iterator itEnd = data->mInTextureFileNameVector.end();
-		String compareBaseName;
-		String fileName;
-		for (it = itStart; it != itEnd; ++it)
-		{
-			fileName = *it;
-			//LogManager::getSingleton().logMessage("getFullFileNameFromTextureList - Texture in vector: " + fileName);
-			compareBaseName = fileName.substr(fileName.find_last_of("/\\") + 1);
-			if (baseName == compareBaseName)
-			{
-				gTempString = fileName;
-				return gTempString;
-			}
-		}
-
-		return gTempString;
+		ExportEntry entry;
+		entry.nameInZip = nameInZip;
+		entry.content = content;
+		entry.inMemory = true;
+		entry.archiveFile = NULL;
+		mExportEntries.push_back(entry);
 	}
 
 	//---------------------------------------------------------------------
-	const String& ProjectImportExportPlugin::getFullFileNameFromResources(const String& baseName, HlmsEditorPluginData* data)
+	bool ProjectImportExportPlugin::addTextureToExport (const String& fileNameSource, const String& nameInZip)
 	{
-		// Only search in the default resource group, because that is the only group the HLMS Editor uses
-		gTempString = "";
-		String filename;
-		String path;
-		FileInfoListPtr list = ResourceGroupManager::getSingleton().listResourceFileInfo(ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-		FileInfoList::iterator it;
-		FileInfoList::iterator itStart = list->begin();
-		FileInfoList::iterator itEnd = list->end();
-		for (it = itStart; it != itEnd; ++it)
+		// Textures with the same name are only added once; the last source wins (as it did when the files were copied)
+		size_t index = mTextureEntries.find(nameInZip);
+		if (index != ProjectNameIndex::NOT_FOUND)
 		{
-			FileInfo& fileInfo = (*it);
-			if (fileInfo.basename == baseName)
-			{
-				gTempString = fileInfo.archive->getName() + "/" + baseName;
-				return gTempString;
-			}
+			mExportEntries[index].fileNameSource = fileNameSource;
+			mExportEntries[index].archiveFile = mTextureResolver.getArchiveFile(fileNameSource);
+			return false;
 		}
 
-		return gTempString;
+		mTextureEntries.add(nameInZip, mExportEntries.size());
+		addFileToExport(fileNameSource, nameInZip);
+		return true;
 	}
 
 	//---------------------------------------------------------------------
-	bool ProjectImportExportPlugin::unzip (const char* zipfilename, HlmsEditorPluginData* data)
+	bool ProjectImportExportPlugin::unzip (ProjectZipReader& zipReader,
+		HlmsEditorPluginData* data,
+		const ProjectNameIndex* excluded,
+		const ProjectNameIndex* thumbNames)
 	{
-		// Open the zip file
-		unzFile zipfile;
-		//zipfile = unzOpen(zipfilename);
-		zipfile = unzOpen64(zipfilename);
-		if (zipfile == NULL)
+		// The entries are extracted in parallel, unless the property says otherwise. Each worker has its own handle
+		// on the zip file and its own share of the entries; the shares are balanced by compressed size (largest first,
+		// each to the worker with the least work so far). The first worker uses the handle of the validation.
+		bool parallel = true;
+		std::map<std::string, Ogre::HlmsEditorPluginData::PLUGIN_PROPERTY>::iterator itProperties = data->mInPropertiesMap.find("import_parallel");
+		if (itProperties != data->mInPropertiesMap.end())
+			parallel = (itProperties->second).boolValue;
+
+		// Excluded entries and the cfg files (which are rewritten from memory) are done without extracting them
+		ProjectJobProgress& progress = mJob.getProgress();
+		const std::vector<ImportEntry>& entries = zipReader.getEntries();
+		std::vector<const ImportEntry*> sorted;
+		sorted.reserve(entries.size());
+		std::vector<ImportEntry>::const_iterator it;
+		for (it = entries.begin(); it != entries.end(); ++it)
 		{
-			data->mOutErrorText = "Error while opening import file: " + data->mInExportPath + data->mInFileDialogName;
-			return false;
+			if (isCfgFileForImport((*it).nameInZip) ||
+				(excluded && excluded->find((*it).nameInZip) != ProjectNameIndex::NOT_FOUND))
+				progress.addDone((*it).uncompressedSize, 1);
+			else
+				sorted.push_back(&(*it));
 		}
 
-		// Get info about the zip file
-		unz_global_info global_info;
-		if (unzGetGlobalInfo(zipfile, &global_info) != UNZ_OK)
+		size_t numberOfWorkers = parallel ? std::max((size_t)1, (size_t)std::thread::hardware_concurrency()) : 1;
+		numberOfWorkers = std::min(numberOfWorkers, std::max((size_t)1, sorted.size()));
+		std::stable_sort(sorted.begin(), sorted.end(), [](const ImportEntry* a, const ImportEntry* b) { return a->compressedSize > b->compressedSize; });
+
+		std::vector< std::vector<const ImportEntry*> > shares(numberOfWorkers);
+		std::vector<ZPOS64_T> load(numberOfWorkers, 0);
+		std::vector<const ImportEntry*>::iterator itSorted;
+		for (itSorted = sorted.begin(); itSorted != sorted.end(); ++itSorted)
 		{
-			data->mOutErrorText = "Error while readinf import file";
-			unzClose(zipfile);
-			return false;
+			size_t worker = std::min_element(load.begin(), load.end()) - load.begin();
+			shares[worker].push_back(*itSorted);
+			load[worker] += (*itSorted)->compressedSize;
 		}
 
-		// Buffer to hold data read from the zip file.
-		char read_buffer[READ_SIZE];
-
-		// Loop to extract all files
-		uLong i;
-		for (i = 0; i < global_info.number_entry; ++i)
+		// Each worker keeps the files it extracted; they are removed again if the import is cancelled. The thumbs are
+		// not removed, because ../common/thumbs is shared with the other projects (an existing thumb is overwritten anyway)
+		std::vector< std::vector<String> > extractedFiles(numberOfWorkers);
+		std::vector<String> errorTexts(numberOfWorkers);
+		std::atomic<bool> failed(false);
+		auto extract = [this, &shares, &extractedFiles, &errorTexts, &failed, &progress, thumbNames](size_t worker, ProjectZipReader& reader)
 		{
-			// Get info about current file.
-			unz_file_info file_info;
-			char filename[MAX_FILENAME];
-			if (unzGetCurrentFileInfo(
-				zipfile,
-				&file_info,
-				filename,
-				MAX_FILENAME,
-				NULL, 0, NULL, 0) != UNZ_OK)
-			{
-				data->mOutErrorText = "Error while reading info file";
-				unzClose(zipfile);
-				return false;
-			}
-
-			// Entry is always a file, so extract it.
-			if (unzOpenCurrentFile(zipfile) != UNZ_OK)
+			std::vector<const ImportEntry*>::const_iterator itShare;
+			for (itShare = shares[worker].begin(); itShare != shares[worker].end() && !failed; ++itShare)
 			{
-				data->mOutErrorText = "Could not open a file in the import";
-				unzClose(zipfile);
-				return false;
-			}
-
-			// Open a file to write out the data.
-			String f(filename);
-			f = mProjectPath + f;
-			FILE *out = fopen(f.c_str(), "wb");
-			if (out == NULL)
-			{
-				data->mOutErrorText = "Could not create a destination file";
-				unzCloseCurrentFile(zipfile);
-				unzClose(zipfile);
-				return false;
+				bool thumb = thumbNames && thumbNames->find((*itShare)->nameInZip) != ProjectNameIndex::NOT_FOUND;
+				String fileName = (thumb ? "../common/thumbs/" : mProjectPath) + (*itShare)->nameInZip;
+				if (!reader.extractEntry(**itShare, fileName, &progress))
+				{
+					// Only the thumb is lost if ../common/thumbs is missing or cannot be written; the import goes on
+					if (thumb && !progress.isCancelled())
+					{
+						LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Could not extract " + fileName + ": " + reader.getErrorText());
+						progress.addDone(0, 1);
+						continue;
+					}
+					errorTexts[worker] = reader.getErrorText();
+					failed = true;
+					return;
+				}
+				if (!thumb)
+					extractedFiles[worker].push_back(fileName);
 			}
+		};
 
-			int error = UNZ_OK;
-			do
+		if (numberOfWorkers == 1)
+		{
+			extract(0, zipReader);
+		}
+		else
+		{
+			ProjectThreadPool pool(numberOfWorkers);
+			std::vector<ProjectZipReader> readers(numberOfWorkers - 1);
+			std::vector< std::future<void> > futures;
+			futures.push_back(pool.submit([&extract, &zipReader]() { extract(0, zipReader); }));
+			for (size_t worker = 1; worker < numberOfWorkers; ++worker)
 			{
-				error = unzReadCurrentFile(zipfile, read_buffer, READ_SIZE);
-				if (error < 0)
+				ProjectZipReader* reader = &readers[worker - 1];
+				if (!reader->openForExtraction(zipReader))
 				{
-					data->mOutErrorText = "Error while creating file";
-					unzCloseCurrentFile(zipfile);
-					unzClose(zipfile);
-					return false;
+					errorTexts[worker] = reader->getErrorText();
+					failed = true;
+					break;
 				}
+				futures.push_back(pool.submit([&extract, worker, reader]() { extract(worker, *reader); }));
+			}
 
-				// Write data to file.
-				if (error > 0)
-				{
-					fwrite(read_buffer, error, 1, out); // You should check return of fwrite...
-				}
-			} while (error > 0);
+			std::vector< std::future<void> >::iterator itFutures;
+			for (itFutures = futures.begin(); itFutures != futures.end(); ++itFutures)
+				(*itFutures).wait();
+		}
 
-			fclose(out);
-			unzCloseCurrentFile(zipfile);
+		if (!failed)
+			return true;
 
-			// Go the the next entry listed in the zip file.
-			if ((i + 1) < global_info.number_entry)
+		if (progress.isCancelled())
+		{
+			for (size_t worker = 0; worker < numberOfWorkers; ++worker)
 			{
-				if (unzGoToNextFile(zipfile) != UNZ_OK)
-				{
-					data->mOutErrorText = "Could not read next file in import";
-					unzClose(zipfile);
-					return false;
-				}
+				std::vector<String>::iterator itExtracted;
+				for (itExtracted = extractedFiles[worker].begin(); itExtracted != extractedFiles[worker].end(); ++itExtracted)
+					std::remove((*itExtracted).c_str());
 			}
+			data->mOutErrorText = "Import cancelled";
+			return false;
 		}
 
-		unzClose(zipfile);
-		return true;
+		for (size_t worker = 0; worker < numberOfWorkers; ++worker)
+		{
+			if (!errorTexts[worker].empty())
+			{
+				data->mOutErrorText = errorTexts[worker];
+				break;
+			}
+		}
+		return false;
 	}
 
 	//---------------------------------------------------------------------
-	bool ProjectImportExportPlugin::validateZip(const char* zipfilename, HlmsEditorPluginData* data)
+	bool ProjectImportExportPlugin::validateZip (const ProjectZipReader& zipReader, HlmsEditorPluginData* data)
 	{
 		// Check whether the zip file is a valid HLMS Editor project export
 		// This means that at least the files 'project.txt', 'materials.cfg' and 'textures.cfg'
 		// must be present
-		bool projectPresent = false;
-		bool materialsPresent = false;
-		bool texturesPresent = false;
-
-		// Open the zip file
-		unzFile zipfile;
-		//zipfile = unzOpen(zipfilename);
-		zipfile = unzOpen64(zipfilename);
-		if (zipfile == NULL)
-		{
-			data->mOutErrorText = "Error while opening import file: " + data->mInExportPath + data->mInFileDialogName;
-			return false;
-		}
-
-		// Get info about the zip file
-		unz_global_info global_info;
-		if (unzGetGlobalInfo(zipfile, &global_info) != UNZ_OK)
-		{
-			data->mOutErrorText = "Error while readinf import file";
-			unzClose(zipfile);
-			return false;
-		}
-
-		// Loop to extract all files
-		uLong i;
-		for (i = 0; i < global_info.number_entry; ++i)
+		const std::vector<ImportEntry>& entries = zipReader.getEntries();
+		std::vector<ImportEntry>::const_iterator it;
+		for (it = entries.begin(); it != entries.end(); ++it)
 		{
-			// Get info about current file.
-			unz_file_info file_info;
-			char filename[MAX_FILENAME];
-			if (unzGetCurrentFileInfo(
-				zipfile,
-				&file_info,
-				filename,
-				MAX_FILENAME,
-				NULL, 0, NULL, 0) != UNZ_OK)
-			{
-				data->mOutErrorText = "Error while reading info file";
-				unzClose(zipfile);
-				return false;
-			}
-
-			// Check the name
-			String f(filename);
-			if (Ogre::StringUtil::match(f, "project.txt"))
-				projectPresent = true;
-			if (Ogre::StringUtil::match(f, "materials.cfg"))
-				materialsPresent = true;
-			if (Ogre::StringUtil::match(f, "textures.cfg"))
-				texturesPresent = true;
-
-			// Go the the next entry listed in the zip file.
-			if ((i + 1) < global_info.number_entry)
-			{
-				if (unzGoToNextFile(zipfile) != UNZ_OK)
-				{
-					data->mOutErrorText = "Could not read next file in import";
-					unzClose(zipfile);
-					return false;
-				}
-			}
+			// The total amount of work of the import is the uncompressed size of all entries
+			mJob.getProgress().addTotal((*it).uncompressedSize, 1);
 		}
 
-		unzClose(zipfile);
-
-		if (projectPresent && materialsPresent && texturesPresent)
+		if (zipReader.hasEntry("project.txt") &&
+			zipReader.hasEntry("materials.cfg") &&
+			zipReader.hasEntry("textures.cfg"))
 			return true;
 
 		data->mOutErrorText = "File is not a valid project export";
@@ -866,36 +833,75 @@ namespace Ogre
 	}
 
 	//---------------------------------------------------------------------
-	int ProjectImportExportPlugin::isLargeFile(const char* filename)
+	bool ProjectImportExportPlugin::readContentFromZip (ProjectZipReader& zipReader, const String& nameInZip, String* content)
 	{
-		int largeFile = 0;
-		ZPOS64_T pos = 0;
-		FILE* pFile = FOPEN_FUNC(filename, "rb");
+		const ImportEntry* entry = zipReader.findEntry(nameInZip);
+		if (entry == NULL)
+			return false;
 
-		if (pFile != NULL)
-		{
-			int n = FSEEKO_FUNC(pFile, 0, SEEK_END);
-			pos = FTELLO_FUNC(pFile);
+		content->assign((size_t)entry->uncompressedSize, '\0');
+		return content->empty() || zipReader.readEntry(*entry, &(*content)[0]);
+	}
+	//---------------------------------------------------------------------
+	bool ProjectImportExportPlugin::readTextureNamesFromZip (ProjectZipReader& zipReader, ProjectNameIndex* textureNames)
+	{
+		// The textures are the assets (type 3) in textures.cfg
+		String content;
+		if (!readContentFromZip(zipReader, "textures.cfg", &content))
+			return false;
 
-			//printf("File : %s is %lld bytes\n", filename, pos);
+		std::istringstream src(content);
+		std::string line;
+		int topLevelId;
+		int parentId;
+		int resourceId;
+		int resourceType;
+		String resourceName;
+		String fullQualifiedName;
+		while (std::getline(src, line))
+		{
+			std::istringstream iss(line);
+			if (iss >> topLevelId >> parentId >> resourceId >> resourceType >> resourceName >> fullQualifiedName &&
+				resourceType == 3)
+				textureNames->add(fullQualifiedName);
+		}
 
-			if (pos >= 0xffffffff)
-				largeFile = 1;
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectImportExportPlugin::readThumbNamesFromZip (ProjectZipReader& zipReader, ProjectNameIndex* thumbNames)
+	{
+		// Each material asset (type 3) in materials.cfg has a thumb <resourceName>.png
+		String content;
+		if (!readContentFromZip(zipReader, "materials.cfg", &content))
+			return false;
 
-			fclose(pFile);
+		std::istringstream src(content);
+		std::string line;
+		int topLevelId;
+		int parentId;
+		int resourceId;
+		int resourceType;
+		String resourceName;
+		String fullQualifiedName;
+		while (std::getline(src, line))
+		{
+			std::istringstream iss(line);
+			if (iss >> topLevelId >> parentId >> resourceId >> resourceType >> resourceName >> fullQualifiedName &&
+				resourceType == 3)
+				thumbNames->add(resourceName + ".png");
 		}
 
-		return largeFile;
+		return true;
 	}
-
 	//---------------------------------------------------------------------
-	bool ProjectImportExportPlugin::createProjectFileForImport (HlmsEditorPluginData* data)
+	bool ProjectImportExportPlugin::createProjectFileForImport (ProjectZipReader& zipReader, HlmsEditorPluginData* data)
 	{
 		// File projects.txt must exist
-		String fileName = mProjectPath + "project.txt";
-		std::ifstream src(fileName);
-		if (!src)
+		String content;
+		if (!readContentFromZip(zipReader, "project.txt", &content))
 			return false;
+		std::istringstream src(content);
 
 		// Get the project name
 		mNameProject = "";
@@ -914,29 +920,24 @@ namespace Ogre
 			<< "\n";
 
 		// Only write the entry when the meshes.cfg is available in the .zip file
-		if (isMeshesCfgFileForImport(data))
+		if (isMeshesCfgFileForImport(zipReader))
 		{
 			dst << mFileNameMeshes
 				<< "\n";
 		}
 
-		src.close();
 		dst.close();
-
-		// Remove the project.txt, because it is not used anymore
-		std::remove(fileName.c_str());
-
 		return true;
 	}
 
 	//---------------------------------------------------------------------
-	bool ProjectImportExportPlugin::createMaterialCfgFileForImport(HlmsEditorPluginData* data)
+	bool ProjectImportExportPlugin::createMaterialCfgFileForImport(ProjectZipReader& zipReader, HlmsEditorPluginData* data)
 	{
 		// File materials.cfg must exist
-		String materialsName = mProjectPath + "materials.cfg";
-		std::ifstream src(materialsName);
-		if (!src)
+		String content;
+		if (!readContentFromZip(zipReader, "materials.cfg", &content))
 			return false;
+		std::istringstream src(content);
 
 		// Read materials.cfg and create <project>_materials.cfg, including path
 		std::ofstream dst(mFileNameMaterials);
@@ -947,8 +948,6 @@ namespace Ogre
 		int resourceType;
 		String resourceName;
 		String fullQualifiedName;
-		String thumbFileNameSource;
-		String thumbFileNameDestination;
 		while (std::getline(src, line))
 		{
 			// Read
@@ -961,14 +960,8 @@ namespace Ogre
 				>> fullQualifiedName;
 			if (resourceType == 3)
 			{
-				// Enrich the fullQualifiedName
+				// Enrich the fullQualifiedName (the thumb images are already extracted to ../common/thumbs)
 				fullQualifiedName = mProjectPath + fullQualifiedName; // Only enrich type = 3 (assets) and not groups
-
-				// Copy the thumb images
-				thumbFileNameSource = mProjectPath + resourceName + ".png";
-				thumbFileNameDestination = "../common/thumbs/" + resourceName + ".png";
-				copyFile(thumbFileNameSource, thumbFileNameDestination);
-				std::remove(thumbFileNameSource.c_str());
 			}
 
 			// Write
@@ -985,22 +978,18 @@ namespace Ogre
 				<< fullQualifiedName
 				<< "\n";
 		}
-		src.close();
 		dst.close();
-
-		// Remove the materials.txt, because it is not used anymore
-		std::remove(materialsName.c_str());
 		return true;
 	}
 
 	//---------------------------------------------------------------------
-	bool ProjectImportExportPlugin::createTextureCfgFileForImport(HlmsEditorPluginData* data)
+	bool ProjectImportExportPlugin::createTextureCfgFileForImport(ProjectZipReader& zipReader, HlmsEditorPluginData* data)
 	{
 		// File textures.cfg must exist
-		String texturesName = mProjectPath + "textures.cfg";
-		std::ifstream src(texturesName);
-		if (!src)
+		String content;
+		if (!readContentFromZip(zipReader, "textures.cfg", &content))
 			return false;
+		std::istringstream src(content);
 
 		// Read materials.cfg and create <project>_materials.cfg, including path
 		std::ofstream dst(mFileNameTextures);
@@ -1020,8 +1009,12 @@ namespace Ogre
 				>> resourceType
 				>> resourceName
 				>> fullQualifiedName;
-			if (resourceType == 3)
-				fullQualifiedName = mProjectPath + fullQualifiedName; // Only enrich type = 3 (assets) and not groups
+			// Only enrich type = 3 (assets) and not groups. The textures of a mounted zip file are not extracted; they
+			// get the name under which the archive serves them in the Ogre resources, which the export resolves again
+			if (resourceType == 3 && mMountedZip.empty())
+				fullQualifiedName = mProjectPath + fullQualifiedName;
+			else if (resourceType == 3)
+				fullQualifiedName = mMountedZip + "/" + fullQualifiedName;
 			dst << topLevelId
 				<< "\t"
 				<< parentId
@@ -1035,35 +1028,24 @@ namespace Ogre
 				<< fullQualifiedName
 				<< "\n";
 		}
-		src.close();
 		dst.close();
-
-		// Remove the textures.txt, because it is not used anymore
-		std::remove(texturesName.c_str());
 		return true;
 	}
 
 	//---------------------------------------------------------------------
-	bool ProjectImportExportPlugin::isMeshesCfgFileForImport (HlmsEditorPluginData* data)
+	bool ProjectImportExportPlugin::isMeshesCfgFileForImport (const ProjectZipReader& zipReader)
 	{
-		bool result = false;
-		String meshesName = mProjectPath + "meshes.cfg";
-		std::ifstream src(meshesName);
-		if (src)
-			result = true;
-
-		src.close();
-		return result;
+		return zipReader.hasEntry("meshes.cfg");
 	}
 
 	//---------------------------------------------------------------------
-	bool ProjectImportExportPlugin::createMeshesCfgFileForImport (HlmsEditorPluginData* data)
+	bool ProjectImportExportPlugin::createMeshesCfgFileForImport (ProjectZipReader& zipReader, HlmsEditorPluginData* data)
 	{
 		// File meshes.cfg is optional
-		String meshesName = mProjectPath + "meshes.cfg";
-		std::ifstream src(meshesName);
-		if (!src)
+		String content;
+		if (!readContentFromZip(zipReader, "meshes.cfg", &content))
 			return true; // Always return true, because it is optional
+		std::istringstream src(content);
 
 		// Read meshes.cfg and create <project>_meshes.cfg, including path
 		std::ofstream dst(mFileNameMeshes);
@@ -1073,11 +1055,7 @@ namespace Ogre
 			line = mProjectPath + line;
 			dst << line;
 		}
-		src.close();
 		dst.close();
-
-		// Remove the meshes.txt, because it is not used anymore
-		std::remove(meshesName.c_str());
 		return true;
 	}
 
@@ -1086,11 +1064,7 @@ namespace Ogre
 	{
 		// Add a project.txt to the zip, containing the projectname
 		// This is only to set the name of the project. This name is used later when the .zip file is imported again
-		String fileName = data->mInExportPath + "project.txt";
-		std::ofstream file(fileName);
-		file << data->mInProjectName;
-		mFileNamesDestination.push_back(fileName);
-		file.close();
+		addContentToExport(data->mInProjectName, "project.txt");
 		return true;
 	}
 
@@ -1108,8 +1082,7 @@ namespace Ogre
 		String fileNameMaterialSource = data->mInMaterialFileName;
 		std::ifstream src(fileNameMaterialSource);
 		String baseNameMaterial = fileNameMaterialSource.substr(fileNameMaterialSource.find_last_of("/\\") + 1);
-		String fileNameMaterialDestination = data->mInExportPath + "materials.cfg";
-		std::ofstream dst(fileNameMaterialDestination);
+		std::ostringstream dst;
 		String topLevelId;
 		String parentId;
 		String resourceId;
@@ -1139,8 +1112,7 @@ namespace Ogre
 				<< "\n";
 		}
 		src.close();
-		dst.close();
-		mFileNamesDestination.push_back(fileNameMaterialDestination);
+		addContentToExport(dst.str(), "materials.cfg");
 		return true;
 	}
 
@@ -1159,8 +1131,7 @@ namespace Ogre
 		String fileNameTextureSource = data->mInTextureFileName;
 		std::ifstream src(fileNameTextureSource);
 		String baseNameTexture;
-		String fileNameTextureDestination = data->mInExportPath + "textures.cfg";
-		std::ofstream dst(fileNameTextureDestination);
+		std::ostringstream dst;
 		int topLevelId;
 		int parentId;
 		int resourceId;
@@ -1196,7 +1167,7 @@ namespace Ogre
 				<< baseNameTexture
 				<< "\n";
 
-			removeFromUniqueTextureFiles(baseNameTexture);
+			mUniqueTextureFiles.remove(baseNameTexture);
 		}
 		src.close();
 
@@ -1204,14 +1175,15 @@ namespace Ogre
 		// Note, that if any textures with the same base filename from different locations are overwritten by duplicate files (with the same base file name, but
 		// different paths).
 		// Keep the base name of the file unique to prevent this !
-		std::vector<String>::iterator itTex = mUniqueTextureFiles.begin();
-		std::vector<String>::iterator itTexEnd = mUniqueTextureFiles.end();
 		String fileName;
 		resourceId = maxResourceId;
 		resourceType = 3; // It must be an asset
-		while (itTex != itTexEnd)
+		for (size_t itTex = 0; itTex < mUniqueTextureFiles.getCount(); ++itTex)
 		{
-			fileName = *itTex;
+			// Skip the textures that are already in the texture browser
+			if (mUniqueTextureFiles.isRemoved(itTex))
+				continue;
+			fileName = mUniqueTextureFiles.getName(itTex);
 
 			// Write the entry
 			if (!fileName.empty())
@@ -1230,12 +1202,9 @@ namespace Ogre
 					<< fileName
 					<< "\n";
 			}
-
-			itTex++;
 		}
 
-		dst.close();
-		mFileNamesDestination.push_back(fileNameTextureDestination);
+		addContentToExport(dst.str(), "textures.cfg");
 		return true;
 	}
 
@@ -1245,8 +1214,7 @@ namespace Ogre
 		// Create the meshes cfg file with all unique meshes. For nowm this is just one mesh
 		String fileNameMeshesSource = data->mInMeshesFileName;
 		String baseNameMeshes = fileNameMeshesSource.substr(fileNameMeshesSource.find_last_of("/\\") + 1);
-		String fileNameMeshesDestination = data->mInExportPath + "meshes.cfg";
-		std::ofstream dst(fileNameMeshesDestination);
+		std::ostringstream dst;
 
 		std::vector<String> meshes;
 		meshes = data->mInMeshFileNames;
@@ -1266,74 +1234,25 @@ namespace Ogre
 			}
 		}
 
-		dst.close();
-		mFileNamesDestination.push_back(fileNameMeshesDestination);
+		addContentToExport(dst.str(), "meshes.cfg");
 		return true;
 	}
 
 	//---------------------------------------------------------------------
-	void ProjectImportExportPlugin::removeFromUniqueTextureFiles(const String& fileName)
-	{
-		std::vector<String>::iterator itDest = mUniqueTextureFiles.begin();
-		std::vector<String>::iterator itDestEnd = mUniqueTextureFiles.end();
-		String compareFileName = fileName;
-		Ogre::StringUtil::toUpperCase(compareFileName);
-		String destFileName;
-		while (itDest != itDestEnd)
-		{
-			destFileName = *itDest;
-			Ogre::StringUtil::toUpperCase(destFileName);
-			if (Ogre::StringUtil::match(compareFileName, destFileName))
-			{
-				itDest = mUniqueTextureFiles.erase(itDest);
-				itDestEnd = mUniqueTextureFiles.end();
-				return;
-			}
-
-			itDest++;
-		}
-	}
-
-	//---------------------------------------------------------------------
-	bool ProjectImportExportPlugin::isDestinationFileAvailableInVector (const String& fileName)
-	{
-		std::vector<String>::iterator itDest = mFileNamesDestination.begin();
-		std::vector<String>::iterator itDestEnd = mFileNamesDestination.end();
-		String compareFileName = fileName;
-		Ogre::StringUtil::toUpperCase(compareFileName);
-		String destFileName;
-		while (itDest != itDestEnd)
-		{
-			destFileName = *itDest;
-			Ogre::StringUtil::toUpperCase(destFileName);
-			if (Ogre::StringUtil::match(compareFileName, destFileName))
-				return true;
-			
-			itDest++;
-		}
-
-		return false;
-	}
-
-	//---------------------------------------------------------------------
-	void ProjectImportExportPlugin::copyFile(const String& fileNameSource, const String& fileNameDestination)
+	bool ProjectImportExportPlugin::copyFile(const String& fileNameSource, const String& fileNameDestination, String* errorText)
 	{
 		if (Ogre::StringUtil::match(fileNameSource, fileNameDestination))
-			return;
+			return true;
 
-		std::ifstream src(fileNameSource.c_str(), std::ios::binary);
-		std::ofstream dst(fileNameDestination.c_str(), std::ios::binary);
-		dst << src.rdbuf();
-		dst.close();
-		src.close();
-		//LogManager::getSingleton().logMessage("Copied files: " + fileNameSource + " to " + fileNameDestination);
-	}
+		// Reflink, in-kernel copy or buffered copy, whatever the file system supports; a cancelled job stops within one chunk
+		ProjectFileCopy fileCopy;
+		if (fileCopy.copy(fileNameSource, fileNameDestination, &mJob.getProgress()))
+			return true;
 
-	//---------------------------------------------------------------------
-	void ProjectImportExportPlugin::mySleep (clock_t sec)
-	{
-		clock_t start_time = clock();
-		clock_t end_time = sec * 1000 + start_time;
-		while (clock() != end_time);
+		if (!mJob.getProgress().isCancelled())
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: " + fileCopy.getErrorText());
+		if (errorText)
+			*errorText = fileCopy.getErrorText();
+		return false;
 	}
 }
@@ -0,0 +1,179 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectJob.h"
+
+namespace Ogre
+{
+	//---------------------------------------------------------------------
+	ProjectJobProgress::ProjectJobProgress (void)
+	{
+		reset();
+	}
+	//---------------------------------------------------------------------
+	ProjectJobProgress::~ProjectJobProgress (void)
+	{
+	}
+	//---------------------------------------------------------------------
+	void ProjectJobProgress::reset (void)
+	{
+		mBytesDone = 0;
+		mBytesTotal = 0;
+		mEntriesDone = 0;
+		mEntriesTotal = 0;
+		mCancelled = false;
+	}
+	//---------------------------------------------------------------------
+	void ProjectJobProgress::addTotal (uint64 bytes, size_t entries)
+	{
+		mBytesTotal += bytes;
+		mEntriesTotal += entries;
+	}
+	//---------------------------------------------------------------------
+	void ProjectJobProgress::addDone (uint64 bytes, size_t entries)
+	{
+		mBytesDone += bytes;
+		mEntriesDone += entries;
+	}
+	//---------------------------------------------------------------------
+	void ProjectJobProgress::cancel (void)
+	{
+		mCancelled = true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectJobProgress::isCancelled (void) const
+	{
+		return mCancelled;
+	}
+	//---------------------------------------------------------------------
+	uint64 ProjectJobProgress::getBytesDone (void) const
+	{
+		return mBytesDone;
+	}
+	//---------------------------------------------------------------------
+	uint64 ProjectJobProgress::getBytesTotal (void) const
+	{
+		return mBytesTotal;
+	}
+	//---------------------------------------------------------------------
+	size_t ProjectJobProgress::getEntriesDone (void) const
+	{
+		return mEntriesDone;
+	}
+	//---------------------------------------------------------------------
+	size_t ProjectJobProgress::getEntriesTotal (void) const
+	{
+		return mEntriesTotal;
+	}
+	//---------------------------------------------------------------------
+	ProjectJob::ProjectJob (void) :
+		mFinished(false),
+		mRunning(false),
+		mResult(false)
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectJob::~ProjectJob (void)
+	{
+		if (mThread.joinable())
+		{
+			mProgress.cancel();
+			mThread.join();
+		}
+	}
+	//---------------------------------------------------------------------
+	bool ProjectJob::start (const Work& work, const Completion& completion)
+	{
+		if (mRunning)
+			return false;
+
+		mProgress.reset();
+		mFinished = false;
+		mRunning = true;
+		mResult = false;
+		mCompletion = completion;
+		mThread = std::thread([this, work]()
+		{
+			mResult = work();
+			mFinished = true;
+		});
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	void ProjectJob::cancel (void)
+	{
+		if (mRunning)
+			mProgress.cancel();
+	}
+	//---------------------------------------------------------------------
+	bool ProjectJob::isRunning (void) const
+	{
+		return mRunning;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectJob::poll (void)
+	{
+		if (!mRunning || !mFinished)
+			return false;
+
+		complete();
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectJob::wait (void)
+	{
+		if (!mRunning)
+			return mResult;
+
+		complete();
+		return mResult;
+	}
+	//---------------------------------------------------------------------
+	ProjectJobProgress& ProjectJob::getProgress (void)
+	{
+		return mProgress;
+	}
+	//---------------------------------------------------------------------
+	const ProjectJobProgress& ProjectJob::getProgress (void) const
+	{
+		return mProgress;
+	}
+	//---------------------------------------------------------------------
+	void ProjectJob::complete (void)
+	{
+		// Joining also makes the results of the work visible to this thread
+		mThread.join();
+		mRunning = false;
+
+		Completion completion;
+		completion.swap(mCompletion);
+		if (completion)
+			completion(mResult);
+	}
+}
@@ -0,0 +1,148 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectMappedFile.h"
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#else
+#	include <sys/types.h>
+#	include <sys/mman.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+namespace Ogre
+{
+	//---------------------------------------------------------------------
+	ProjectMappedFile::ProjectMappedFile (void) :
+		mData(NULL),
+		mSize(0),
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+		mFile(INVALID_HANDLE_VALUE)
+#else
+		mFile(-1)
+#endif
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectMappedFile::~ProjectMappedFile (void)
+	{
+		close();
+	}
+	//---------------------------------------------------------------------
+	bool ProjectMappedFile::create (const String& fileName, uint64 size)
+	{
+		close();
+		if (size == 0 || size > (uint64)((size_t)-1))
+			return false;
+
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+		HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		// Setting the end of the file allocates its space
+		LARGE_INTEGER fileSize;
+		fileSize.QuadPart = (LONGLONG)size;
+		HANDLE mapping = NULL;
+		if (SetFilePointerEx(file, fileSize, NULL, FILE_BEGIN) && SetEndOfFile(file))
+			mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, 0, 0, NULL);
+		if (mapping)
+		{
+			mData = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+		if (mData == NULL)
+		{
+			CloseHandle(file);
+			return false;
+		}
+#else
+		int file = open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666);
+		if (file < 0)
+			return false;
+
+		// Preallocate, so running out of space is an error here and not a fault (SIGBUS) while writing to the mapping.
+		// A file that is only sized with ftruncate is sparse, so it is not mapped; if the space cannot be allocated
+		// (a full disk, or no posix_fallocate), the caller writes the file without a mapping and reports any error.
+		// posix_fallocate of glibc writes the blocks itself if the file system cannot preallocate.
+		bool sized = false;
+#	if defined(__linux__) || defined(__FreeBSD__)
+		sized = posix_fallocate(file, 0, (off_t)size) == 0;
+#	endif
+		if (sized)
+		{
+			void* data = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+			if (data != MAP_FAILED)
+				mData = (unsigned char*)data;
+		}
+		if (mData == NULL)
+		{
+			::close(file);
+			return false;
+		}
+#endif
+
+		mFile = file;
+		mSize = size;
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectMappedFile::close (void)
+	{
+		bool result = true;
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+		if (mData)
+			result = UnmapViewOfFile(mData) != 0;
+		if (mFile != INVALID_HANDLE_VALUE)
+			result = (CloseHandle(mFile) != 0) && result;
+		mFile = INVALID_HANDLE_VALUE;
+#else
+		if (mData)
+			result = munmap(mData, (size_t)mSize) == 0;
+		if (mFile >= 0)
+			result = (::close(mFile) == 0) && result;
+		mFile = -1;
+#endif
+		mData = NULL;
+		mSize = 0;
+		return result;
+	}
+	//---------------------------------------------------------------------
+	unsigned char* ProjectMappedFile::getData (void) const
+	{
+		return mData;
+	}
+	//---------------------------------------------------------------------
+	uint64 ProjectMappedFile::getSize (void) const
+	{
+		return mSize;
+	}
+}
@@ -0,0 +1,350 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectMaterialScanner.h"
+#include <fstream>
+#include <cstring>
+
+namespace Ogre
+{
+	// Nesting deeper than this is not a material file; it also protects the (recursive) parser
+	static const size_t MAX_DEPTH = 64;
+
+	//---------------------------------------------------------------------
+	ProjectMaterialScanner::ProjectMaterialScanner (void) :
+		mCurrent(0),
+		mEnd(0)
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectMaterialScanner::~ProjectMaterialScanner (void)
+	{
+	}
+	//---------------------------------------------------------------------
+	bool ProjectMaterialScanner::scanFile (const String& fileName, std::vector<String>& textureNames)
+	{
+		std::ifstream inFile(fileName.c_str(), std::ios::in | std::ios::binary);
+		if (!inFile)
+			return setError("Cannot open material file " + fileName);
+
+		inFile.seekg(0, std::ios::end);
+		std::streamoff length = inFile.tellg();
+		inFile.seekg(0, std::ios::beg);
+		if (length < 0)
+			return setError("Cannot read material file " + fileName);
+
+		mBuffer.resize((size_t)length);
+		if (length > 0 && !inFile.read(&mBuffer[0], length))
+			return setError("Cannot read material file " + fileName);
+
+		if (!scan(mBuffer.empty() ? "" : &mBuffer[0], mBuffer.size(), textureNames))
+		{
+			mErrorText = mErrorText + " in " + fileName;
+			return false;
+		}
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectMaterialScanner::scan (const char* json, size_t length, std::vector<String>& textureNames)
+	{
+		mErrorText = "";
+		mCurrent = json;
+		mEnd = json + length;
+
+		// Skip an UTF-8 byte order mark
+		if (length >= 3 && memcmp(json, "\xEF\xBB\xBF", 3) == 0)
+			mCurrent += 3;
+
+		skipWhitespace();
+		if (mCurrent == mEnd || *mCurrent != '{')
+			return setError("Material file is not a Json object");
+
+		if (!parseValue(0, false, false, textureNames))
+			return false;
+
+		skipWhitespace();
+		if (mCurrent != mEnd)
+			return setError("Unexpected data after the Json object");
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	const String& ProjectMaterialScanner::getErrorText (void) const
+	{
+		return mErrorText;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectMaterialScanner::parseValue (size_t depth, bool inSection, bool isTexture, std::vector<String>& textureNames)
+	{
+		skipWhitespace();
+		if (mCurrent == mEnd)
+			return setError("Unexpected end of the Json data");
+
+		switch (*mCurrent)
+		{
+			case '{':
+				return parseObject(depth + 1, inSection, textureNames);
+
+			case '[':
+				return parseArray(depth + 1, inSection, isTexture, textureNames);
+
+			case '"':
+			{
+				if (!isTexture)
+					return parseString(0);
+
+				String textureName;
+				if (!parseString(&textureName))
+					return false;
+
+				textureName = textureName.substr(textureName.find_last_of("/\\") + 1);
+				if (!textureName.empty())
+					textureNames.push_back(textureName);
+				return true;
+			}
+
+			default:
+				return skipLiteral();
+		}
+	}
+	//---------------------------------------------------------------------
+	bool ProjectMaterialScanner::parseObject (size_t depth, bool inSection, std::vector<String>& textureNames)
+	{
+		if (depth > MAX_DEPTH)
+			return setError("Json data is nested too deep");
+
+		++mCurrent; // '{'
+		skipWhitespace();
+		if (mCurrent != mEnd && *mCurrent == '}')
+		{
+			++mCurrent;
+			return true;
+		}
+
+		bool keyInSection;
+		bool keyIsTexture;
+		while (true)
+		{
+			skipWhitespace();
+			if (mCurrent == mEnd || *mCurrent != '"')
+				return setError("Expected a Json key");
+
+			// Keys only need to be decoded at the top level (the section) and inside a section
+			if (depth == 1 || inSection)
+			{
+				if (!parseString(&mKey))
+					return false;
+				keyInSection = inSection || mKey == "pbs" || mKey == "unlit";
+				keyIsTexture = inSection && mKey == "texture";
+			}
+			else
+			{
+				if (!parseString(0))
+					return false;
+				keyInSection = false;
+				keyIsTexture = false;
+			}
+
+			skipWhitespace();
+			if (mCurrent == mEnd || *mCurrent != ':')
+				return setError("Expected ':' after a Json key");
+			++mCurrent;
+
+			if (!parseValue(depth, keyInSection, keyIsTexture, textureNames))
+				return false;
+
+			skipWhitespace();
+			if (mCurrent == mEnd)
+				return setError("Unexpected end of the Json data");
+			if (*mCurrent == '}')
+			{
+				++mCurrent;
+				return true;
+			}
+			if (*mCurrent != ',')
+				return setError("Expected ',' or '}' in a Json object");
+			++mCurrent;
+		}
+	}
+	//---------------------------------------------------------------------
+	bool ProjectMaterialScanner::parseArray (size_t depth, bool inSection, bool isTexture, std::vector<String>& textureNames)
+	{
+		if (depth > MAX_DEPTH)
+			return setError("Json data is nested too deep");
+
+		++mCurrent; // '['
+		skipWhitespace();
+		if (mCurrent != mEnd && *mCurrent == ']')
+		{
+			++mCurrent;
+			return true;
+		}
+
+		while (true)
+		{
+			if (!parseValue(depth, inSection, isTexture, textureNames))
+				return false;
+
+			skipWhitespace();
+			if (mCurrent == mEnd)
+				return setError("Unexpected end of the Json data");
+			if (*mCurrent == ']')
+			{
+				++mCurrent;
+				return true;
+			}
+			if (*mCurrent != ',')
+				return setError("Expected ',' or ']' in a Json array");
+			++mCurrent;
+		}
+	}
+	//---------------------------------------------------------------------
+	bool ProjectMaterialScanner::parseString (String* decoded)
+	{
+		++mCurrent; // '"'
+		if (decoded)
+			decoded->clear();
+
+		while (true)
+		{
+			// Jump to the next quote; memchr is vectorised by the C runtime, so most of the string is never
+			// looked at byte by byte. Only a backslash in the skipped part needs attention.
+			const char* quote = (const char*)memchr(mCurrent, '"', mEnd - mCurrent);
+			if (!quote)
+				return setError("Unterminated Json string");
+
+			const char* backslash = (const char*)memchr(mCurrent, '\\', quote - mCurrent);
+			if (!backslash)
+			{
+				if (decoded)
+					decoded->append(mCurrent, quote);
+				mCurrent = quote + 1;
+				return true;
+			}
+
+			if (decoded)
+				decoded->append(mCurrent, backslash);
+			mCurrent = backslash + 1;
+			if (mCurrent == mEnd)
+				return setError("Unterminated Json string");
+
+			char escaped = *mCurrent++;
+			if (escaped == 'u')
+			{
+				if (mEnd - mCurrent < 4)
+					return setError("Invalid Json escape sequence");
+
+				unsigned int codePoint = 0;
+				for (int i = 0; i < 4; ++i)
+				{
+					char c = *mCurrent++;
+					codePoint <<= 4;
+					if (c >= '0' && c <= '9')
+						codePoint |= c - '0';
+					else if (c >= 'a' && c <= 'f')
+						codePoint |= c - 'a' + 10;
+					else if (c >= 'A' && c <= 'F')
+						codePoint |= c - 'A' + 10;
+					else
+						return setError("Invalid Json escape sequence");
+				}
+
+				if (decoded)
+				{
+					// Encode as UTF-8; a surrogate pair is decoded as two separate code points, which is good
+					// enough for texture names
+					if (codePoint < 0x80)
+					{
+						decoded->push_back((char)codePoint);
+					}
+					else if (codePoint < 0x800)
+					{
+						decoded->push_back((char)(0xC0 | (codePoint >> 6)));
+						decoded->push_back((char)(0x80 | (codePoint & 0x3F)));
+					}
+					else
+					{
+						decoded->push_back((char)(0xE0 | (codePoint >> 12)));
+						decoded->push_back((char)(0x80 | ((codePoint >> 6) & 0x3F)));
+						decoded->push_back((char)(0x80 | (codePoint & 0x3F)));
+					}
+				}
+				continue;
+			}
+
+			char c;
+			switch (escaped)
+			{
+				case '"': c = '"'; break;
+				case '\\': c = '\\'; break;
+				case '/': c = '/'; break;
+				case 'b': c = '\b'; break;
+				case 'f': c = '\f'; break;
+				case 'n': c = '\n'; break;
+				case 'r': c = '\r'; break;
+				case 't': c = '\t'; break;
+				default:
+					return setError("Invalid Json escape sequence");
+			}
+			if (decoded)
+				decoded->push_back(c);
+		}
+	}
+	//---------------------------------------------------------------------
+	bool ProjectMaterialScanner::skipLiteral (void)
+	{
+		// Numbers, true, false and null; they are not validated in detail, because they are never used
+		const char* start = mCurrent;
+		while (mCurrent != mEnd)
+		{
+			char c = *mCurrent;
+			if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' || c == 'E')
+				++mCurrent;
+			else
+				break;
+		}
+
+		if (mCurrent == start)
+			return setError("Unexpected character in the Json data");
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	void ProjectMaterialScanner::skipWhitespace (void)
+	{
+		while (mCurrent != mEnd && (*mCurrent == ' ' || *mCurrent == '\t' || *mCurrent == '\n' || *mCurrent == '\r'))
+			++mCurrent;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectMaterialScanner::setError (const String& errorText)
+	{
+		mErrorText = errorText;
+		return false;
+	}
+}
@@ -0,0 +1,112 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectNameIndex.h"
+
+namespace Ogre
+{
+	//---------------------------------------------------------------------
+	ProjectNameIndex::ProjectNameIndex (bool caseSensitive) :
+		mCaseSensitive(caseSensitive)
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectNameIndex::~ProjectNameIndex (void)
+	{
+	}
+	//---------------------------------------------------------------------
+	bool ProjectNameIndex::add (const String& name, size_t value)
+	{
+		std::pair<std::unordered_map<String, size_t>::iterator, bool> result = mPositions.insert(std::make_pair(fold(name), mNames.size()));
+		if (!result.second)
+			return false;
+
+		mNames.push_back(name);
+		mValues.push_back(value);
+		mRemoved.push_back(false);
+		return true;
+	}
+	//---------------------------------------------------------------------
+	size_t ProjectNameIndex::find (const String& name) const
+	{
+		std::unordered_map<String, size_t>::const_iterator it = mPositions.find(fold(name));
+		if (it == mPositions.end())
+			return NOT_FOUND;
+
+		return mValues[it->second];
+	}
+	//---------------------------------------------------------------------
+	bool ProjectNameIndex::remove (const String& name)
+	{
+		std::unordered_map<String, size_t>::iterator it = mPositions.find(fold(name));
+		if (it == mPositions.end())
+			return false;
+
+		mRemoved[it->second] = true;
+		mPositions.erase(it);
+		return true;
+	}
+	//---------------------------------------------------------------------
+	void ProjectNameIndex::clear (void)
+	{
+		mNames.clear();
+		mValues.clear();
+		mRemoved.clear();
+		mPositions.clear();
+	}
+	//---------------------------------------------------------------------
+	size_t ProjectNameIndex::getCount (void) const
+	{
+		return mNames.size();
+	}
+	//---------------------------------------------------------------------
+	bool ProjectNameIndex::isRemoved (size_t position) const
+	{
+		return mRemoved[position];
+	}
+	//---------------------------------------------------------------------
+	const String& ProjectNameIndex::getName (size_t position) const
+	{
+		return mNames[position];
+	}
+	//---------------------------------------------------------------------
+	size_t ProjectNameIndex::getValue (size_t position) const
+	{
+		return mValues[position];
+	}
+	//---------------------------------------------------------------------
+	String ProjectNameIndex::fold (const String& name) const
+	{
+		if (mCaseSensitive)
+			return name;
+
+		String folded = name;
+		Ogre::StringUtil::toUpperCase(folded);
+		return folded;
+	}
+}
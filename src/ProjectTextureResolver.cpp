@@ -0,0 +1,108 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "OgreRoot.h"
+#include "ProjectTextureResolver.h"
+#include "ProjectArchive.h"
+
+namespace Ogre
+{
+	//---------------------------------------------------------------------
+	ProjectTextureResolver::ProjectTextureResolver (void)
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectTextureResolver::~ProjectTextureResolver (void)
+	{
+	}
+	//---------------------------------------------------------------------
+	void ProjectTextureResolver::build (const std::vector<String>& textureFileNames)
+	{
+		clear();
+
+		// Only search in the default resource group, because that is the only group the HLMS Editor uses
+		FileInfoListPtr list = ResourceGroupManager::getSingleton().listResourceFileInfo(ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+		FileInfoList::iterator it;
+		FileInfoList::iterator itStart = list->begin();
+		FileInfoList::iterator itEnd = list->end();
+		for (it = itStart; it != itEnd; ++it)
+		{
+			FileInfo& fileInfo = (*it);
+			String fullFileName = fileInfo.archive->getName() + "/" + fileInfo.basename;
+			mResourceFileNames.insert(std::make_pair(fileInfo.basename, fullFileName));
+			// Only the project archive can be read by multiple threads at the same time (the zip writer does that)
+			if (fileInfo.archive->getType() == ProjectArchiveFactory::ARCHIVE_TYPE)
+				mArchiveFiles.insert(std::make_pair(fullFileName, fileInfo));
+		}
+
+		// Texture list of the texture browser
+		std::vector<String>::const_iterator itTextures;
+		std::vector<String>::const_iterator itTexturesStart = textureFileNames.begin();
+		std::vector<String>::const_iterator itTexturesEnd = textureFileNames.end();
+		String fileName;
+		for (itTextures = itTexturesStart; itTextures != itTexturesEnd; ++itTextures)
+		{
+			fileName = *itTextures;
+			mTextureListFileNames.insert(std::make_pair(fileName.substr(fileName.find_last_of("/\\") + 1), fileName));
+		}
+	}
+	//---------------------------------------------------------------------
+	void ProjectTextureResolver::clear (void)
+	{
+		mResourceFileNames.clear();
+		mTextureListFileNames.clear();
+		mArchiveFiles.clear();
+	}
+	//---------------------------------------------------------------------
+	String ProjectTextureResolver::getFullFileNameFromResources (const String& baseName) const
+	{
+		std::unordered_map<String, String>::const_iterator it = mResourceFileNames.find(baseName);
+		if (it == mResourceFileNames.end())
+			return "";
+
+		return it->second;
+	}
+	//---------------------------------------------------------------------
+	String ProjectTextureResolver::getFullFileNameFromTextureList (const String& baseName) const
+	{
+		std::unordered_map<String, String>::const_iterator it = mTextureListFileNames.find(baseName);
+		if (it == mTextureListFileNames.end())
+			return "";
+
+		return it->second;
+	}
+	//---------------------------------------------------------------------
+	const FileInfo* ProjectTextureResolver::getArchiveFile (const String& fullFileName) const
+	{
+		std::unordered_map<String, FileInfo>::const_iterator it = mArchiveFiles.find(fullFileName);
+		if (it == mArchiveFiles.end())
+			return NULL;
+
+		return &it->second;
+	}
+}
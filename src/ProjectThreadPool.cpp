@@ -0,0 +1,88 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectThreadPool.h"
+
+namespace Ogre
+{
+	//---------------------------------------------------------------------
+	ProjectThreadPool::ProjectThreadPool (size_t numberOfThreads) :
+		mStop(false)
+	{
+		if (numberOfThreads == 0)
+			numberOfThreads = std::thread::hardware_concurrency();
+		if (numberOfThreads == 0)
+			numberOfThreads = 1;
+
+		for (size_t i = 0; i < numberOfThreads; ++i)
+			mThreads.push_back(std::thread(&ProjectThreadPool::workerLoop, this));
+	}
+	//---------------------------------------------------------------------
+	ProjectThreadPool::~ProjectThreadPool (void)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStop = true;
+		}
+		mCondition.notify_all();
+
+		std::vector<std::thread>::iterator it = mThreads.begin();
+		std::vector<std::thread>::iterator itEnd = mThreads.end();
+		while (it != itEnd)
+		{
+			(*it).join();
+			++it;
+		}
+	}
+	//---------------------------------------------------------------------
+	size_t ProjectThreadPool::getNumberOfThreads (void) const
+	{
+		return mThreads.size();
+	}
+	//---------------------------------------------------------------------
+	void ProjectThreadPool::workerLoop (void)
+	{
+		std::function<void()> task;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				while (!mStop && mTasks.empty())
+					mCondition.wait(lock);
+
+				// Pending tasks are still executed when the pool is stopped; their futures may be waited for
+				if (mTasks.empty())
+					return;
+
+				task = mTasks.front();
+				mTasks.pop_front();
+			}
+			task();
+		}
+	}
+}
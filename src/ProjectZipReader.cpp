@@ -0,0 +1,310 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectZipReader.h"
+#include "ProjectMappedFile.h"
+#include "iommap.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace Ogre
+{
+	#define READ_SIZE 262144
+	#define MAPPED_CHUNK_SIZE (64 * 1024 * 1024)
+
+	//---------------------------------------------------------------------
+	ProjectZipReader::ProjectZipReader (bool caseSensitive) :
+		mZipFile(NULL),
+		mIndex(caseSensitive),
+		mErrorText("")
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectZipReader::~ProjectZipReader (void)
+	{
+		close();
+	}
+	//---------------------------------------------------------------------
+	unzFile ProjectZipReader::openZipFile (const String& zipName)
+	{
+		zlib_filefunc64_def fileFunc;
+		fill_mmap_filefunc64(&fileFunc);
+		unzFile zipFile = unzOpen2_64(zipName.c_str(), &fileFunc);
+		if (zipFile == NULL)
+			zipFile = unzOpen64(zipName.c_str());
+
+		return zipFile;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipReader::open (const String& zipName)
+	{
+		close();
+		mZipName = zipName;
+		mZipFile = openZipFile(zipName);
+		if (mZipFile == NULL)
+		{
+			mErrorText = "Error while opening import file: " + zipName;
+			return false;
+		}
+
+		unz_global_info64 globalInfo;
+		if (unzGetGlobalInfo64(mZipFile, &globalInfo) != UNZ_OK)
+		{
+			mErrorText = "Error while reading import file";
+			close();
+			return false;
+		}
+
+		// Walk the central directory once
+		mEntries.reserve((size_t)globalInfo.number_entry);
+		char fileName[MAX_FILENAME];
+		unz_file_info64 fileInfo;
+		ImportEntry entry;
+		int err = unzGoToFirstFile(mZipFile);
+		while (err == UNZ_OK)
+		{
+			if (unzGetCurrentFileInfo64(mZipFile, &fileInfo, fileName, MAX_FILENAME, NULL, 0, NULL, 0) != UNZ_OK ||
+				unzGetFilePos64(mZipFile, &entry.position) != UNZ_OK)
+			{
+				err = UNZ_BADZIPFILE;
+				break;
+			}
+
+			entry.nameInZip = fileName;
+			entry.crc = fileInfo.crc;
+			entry.compressedSize = fileInfo.compressed_size;
+			entry.uncompressedSize = fileInfo.uncompressed_size;
+			mEntries.push_back(entry);
+			err = unzGoToNextFile(mZipFile);
+		}
+
+		if (err != UNZ_END_OF_LIST_OF_FILE)
+		{
+			mErrorText = "Error while reading info file";
+			close();
+			return false;
+		}
+
+		buildIndex();
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipReader::openForExtraction (const ProjectZipReader& zipReader)
+	{
+		// Opening only reads the end of the central directory; the positions of the entries are the same for each handle
+		close();
+		mZipName = zipReader.mZipName;
+		mZipFile = openZipFile(mZipName);
+		if (mZipFile == NULL)
+		{
+			mErrorText = "Error while opening import file: " + mZipName;
+			return false;
+		}
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipReader::close (void)
+	{
+		if (mZipFile)
+			unzClose(mZipFile);
+		mZipFile = NULL;
+		mEntries.clear();
+		mIndex.clear();
+	}
+	//---------------------------------------------------------------------
+	const std::vector<ImportEntry>& ProjectZipReader::getEntries (void) const
+	{
+		return mEntries;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipReader::hasEntry (const String& nameInZip) const
+	{
+		return findEntry(nameInZip) != NULL;
+	}
+	//---------------------------------------------------------------------
+	const ImportEntry* ProjectZipReader::findEntry (const String& nameInZip) const
+	{
+		size_t index = mIndex.find(nameInZip);
+		if (index == ProjectNameIndex::NOT_FOUND)
+			return NULL;
+
+		return &mEntries[index];
+	}
+	//---------------------------------------------------------------------
+	const ProjectNameIndex& ProjectZipReader::getIndex (void) const
+	{
+		return mIndex;
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipReader::buildIndex (void)
+	{
+		// The first entry with a name is kept
+		for (size_t i = 0; i < mEntries.size(); ++i)
+			mIndex.add(mEntries[i].nameInZip, i);
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipReader::readEntry (const ImportEntry& entry, void* data)
+	{
+		unz64_file_pos position = entry.position;
+		if (unzGoToFilePos64(mZipFile, &position) != UNZ_OK ||
+			unzOpenCurrentFile(mZipFile) != UNZ_OK)
+		{
+			mErrorText = "Could not open " + entry.nameInZip + " in " + mZipName;
+			return false;
+		}
+
+		// Closing the entry also checks the crc
+		bool result = readCurrentEntry((unsigned char*)data, entry.uncompressedSize, NULL);
+		if (unzCloseCurrentFile(mZipFile) != UNZ_OK)
+			result = false;
+		if (!result)
+			mErrorText = "Could not read " + entry.nameInZip + " in " + mZipName;
+
+		return result;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipReader::extractEntry (const ImportEntry& entry, const String& fileName, ProjectJobProgress* progress)
+	{
+		// Jump directly to the entry; its position is known from the table
+		unz64_file_pos position = entry.position;
+		if (unzGoToFilePos64(mZipFile, &position) != UNZ_OK ||
+			unzOpenCurrentFile(mZipFile) != UNZ_OK)
+		{
+			mErrorText = "Could not open a file in the import";
+			return false;
+		}
+
+		bool result = true;
+		ProjectMappedFile mappedFile;
+		FILE* out = NULL;
+		if (entry.uncompressedSize > 0 && mappedFile.create(fileName, entry.uncompressedSize))
+		{
+			result = readCurrentEntry(mappedFile.getData(), mappedFile.getSize(), progress);
+		}
+		else
+		{
+			out = FOPEN_FUNC(fileName.c_str(), "wb");
+			if (out == NULL)
+			{
+				mErrorText = "Could not create a destination file";
+				unzCloseCurrentFile(mZipFile);
+				return false;
+			}
+			result = writeCurrentEntry(out, fileName, progress);
+		}
+
+		// Closing the entry also checks the crc
+		if (unzCloseCurrentFile(mZipFile) != UNZ_OK && result)
+		{
+			mErrorText = "Error while creating file";
+			result = false;
+		}
+		if (!(out ? fclose(out) == 0 : mappedFile.close()) && result)
+		{
+			mErrorText = "Error while writing " + fileName;
+			result = false;
+		}
+
+		if (!result)
+			std::remove(fileName.c_str());
+		else if (progress)
+			progress->addDone(0, 1);
+
+		return result;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipReader::readCurrentEntry (unsigned char* data, uint64 size, ProjectJobProgress* progress)
+	{
+		// An entry that fits in one chunk is inflated in a single call; because the whole output is then available,
+		// inflate finishes without allocating and updating its sliding window. Larger entries are read per chunk,
+		// so the extraction can be cancelled in between.
+		uint64 done = 0;
+		while (done < size)
+		{
+			if (progress && progress->isCancelled())
+			{
+				mErrorText = "Import cancelled";
+				return false;
+			}
+
+			unsigned len = (unsigned)std::min(size - done, (uint64)MAPPED_CHUNK_SIZE);
+			int sizeRead = unzReadCurrentFile(mZipFile, data + done, len);
+			if (sizeRead <= 0)
+			{
+				mErrorText = "Error while creating file";
+				return false;
+			}
+
+			done += sizeRead;
+			if (progress)
+				progress->addDone(sizeRead, 0);
+		}
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipReader::writeCurrentEntry (FILE* out, const String& fileName, ProjectJobProgress* progress)
+	{
+		mBuffer.resize(READ_SIZE);
+		int sizeRead;
+		do
+		{
+			if (progress && progress->isCancelled())
+			{
+				mErrorText = "Import cancelled";
+				return false;
+			}
+
+			sizeRead = unzReadCurrentFile(mZipFile, &mBuffer[0], (unsigned)mBuffer.size());
+			if (sizeRead < 0)
+			{
+				mErrorText = "Error while creating file";
+				return false;
+			}
+
+			if (sizeRead > 0)
+			{
+				if (fwrite(&mBuffer[0], 1, sizeRead, out) != (size_t)sizeRead)
+				{
+					mErrorText = "Error while writing " + fileName;
+					return false;
+				}
+				if (progress)
+					progress->addDone(sizeRead, 0);
+			}
+		} while (sizeRead > 0);
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	const String& ProjectZipReader::getErrorText (void) const
+	{
+		return mErrorText;
+	}
+}
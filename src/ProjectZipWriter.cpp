@@ -0,0 +1,870 @@
+/*
+  -----------------------------------------------------------------------------
+  This source file is part of OGRE
+  (Object-oriented Graphics Rendering Engine)
+  For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+  THE SOFTWARE.
+  -----------------------------------------------------------------------------
+*/
+
+#include "ProjectZipWriter.h"
+#include "ProjectZipReader.h"
+#include "OgreLogManager.h"
+#include "OgreDataStream.h"
+#include <sys/stat.h>
+
+namespace Ogre
+{
+	#define SPILL_THRESHOLD (64 * 1024 * 1024)
+	#define BLOCK_THRESHOLD (32 * 1024 * 1024)
+	#define BLOCK_SIZE (1024 * 1024)
+	#define DICTIONARY_SIZE 32768
+
+	//---------------------------------------------------------------------
+	ProjectZipWriter::ProjectZipWriter (void) :
+		mNumberOfThreads(0),
+		mSpillThreshold(SPILL_THRESHOLD),
+		mBlockThreshold(BLOCK_THRESHOLD),
+		mIncremental(false),
+		mPreviousZip(NULL),
+		mProgress(NULL),
+		mErrorText("")
+	{
+	}
+	//---------------------------------------------------------------------
+	ProjectZipWriter::~ProjectZipWriter (void)
+	{
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::setNumberOfThreads (size_t numberOfThreads)
+	{
+		mNumberOfThreads = numberOfThreads;
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::setSpillThreshold (size_t spillThreshold)
+	{
+		mSpillThreshold = spillThreshold;
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::setBlockThreshold (ZPOS64_T blockThreshold)
+	{
+		mBlockThreshold = blockThreshold;
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::setCompressionPolicy (const ProjectCompressionPolicy& policy)
+	{
+		mPolicy = policy;
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::setIncremental (bool incremental)
+	{
+		mIncremental = incremental;
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::setProgress (ProjectJobProgress* progress)
+	{
+		mProgress = progress;
+	}
+	//---------------------------------------------------------------------
+	const String& ProjectZipWriter::getErrorText (void) const
+	{
+		return mErrorText;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipWriter::write (const String& zipName, const std::vector<ExportEntry>& entries)
+	{
+		// The zip file is first created under a temporary name. The previous version of the zip file is still
+		// needed during an incremental export, and a failed export does not leave a partial zip file behind.
+		mErrorText = "";
+		if (mIncremental)
+			openPreviousArchive(zipName);
+
+		String tempZipName = zipName + ".tmp";
+		zipFile zf = zipOpen64(tempZipName.c_str(), 0);
+		if (zf == NULL)
+		{
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error opening " + tempZipName);
+			mErrorText = "Could not create " + zipName;
+			closePreviousArchive();
+			return false;
+		}
+
+		LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Creating  " + zipName);
+
+		// All entries are prepared up front, so the total amount of work is known before compressing starts
+		size_t numberOfEntries = entries.size();
+		std::vector<CompressedEntry> results(numberOfEntries);
+		ZPOS64_T totalSize = 0;
+		for (size_t i = 0; i < numberOfEntries; ++i)
+		{
+			prepareEntry(entries[i], &results[i]);
+			totalSize += results[i].sourceSize;
+		}
+		if (mProgress)
+			mProgress->addTotal(totalSize, numberOfEntries);
+
+		// The number of entries that are compressed, but not yet written, is limited; this limits the memory usage
+		ProjectThreadPool pool(mNumberOfThreads);
+		size_t window = 2 * pool.getNumberOfThreads();
+		std::vector< std::future<void> > futures(numberOfEntries);
+		size_t submitted = 0;
+		size_t written = 0;
+		bool result = true;
+		while (written < numberOfEntries)
+		{
+			while (submitted < numberOfEntries && submitted < written + window)
+			{
+				const ExportEntry* entry = &entries[submitted];
+				CompressedEntry* compressed = &results[submitted];
+				if (compressed->skipped || compressed->blockParallel)
+					futures[submitted] = pool.submit([]() {}); // Compressed when it is its turn to be written
+				else
+					futures[submitted] = pool.submit([this, entry, compressed]() { compressEntry(*entry, compressed); });
+				++submitted;
+			}
+
+			futures[written].wait();
+			if (result && isCancelled())
+				result = false;
+			if (result && results[written].blockParallel)
+				result = appendBlockParallelEntry(zf, entries[written], &results[written], pool);
+			else if (result)
+				result = appendEntry(zf, entries[written], &results[written]);
+			releaseEntry(&results[written]);
+
+			// The bytes of a block-parallel entry are reported per block
+			if (result && mProgress)
+				mProgress->addDone(results[written].blockParallel ? 0 : results[written].sourceSize, 1);
+			++written;
+
+			// In case of an error, only wait for the submitted tasks to finish
+			if (!result)
+				numberOfEntries = submitted;
+		}
+
+		// Close the zipfile and replace the previous version
+		int errclose = zipClose(zf, NULL);
+		if (errclose != ZIP_OK)
+		{
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error in closing " + tempZipName);
+			result = false;
+		}
+		closePreviousArchive();
+
+		if (result)
+		{
+			std::remove(zipName.c_str());
+			if (std::rename(tempZipName.c_str(), zipName.c_str()) != 0)
+			{
+				LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error renaming " + tempZipName + " to " + zipName);
+				result = false;
+			}
+		}
+
+		if (!result)
+		{
+			std::remove(tempZipName.c_str());
+			if (isCancelled())
+				mErrorText = "Export cancelled";
+			else if (mErrorText.empty())
+				mErrorText = "Error while creating " + zipName;
+		}
+
+		return result;
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::prepareEntry (const ExportEntry& entry, CompressedEntry* result)
+	{
+		// Executed by the calling thread, before the entry is compressed
+		result->skipped = false;
+		result->valid = true;
+		result->reuse = false;
+		result->previous = NULL;
+		result->spill = NULL;
+		if (entry.inMemory)
+		{
+			statSourceFile(NULL, &result->zi, &result->sourceSize);
+			result->sourceSize = entry.content.size();
+			result->blockParallel = false;
+			return;
+		}
+
+		// The size of a file in an archive is known from its file info; it has no modification time
+		if (entry.archiveFile)
+		{
+			statSourceFile(NULL, &result->zi, &result->sourceSize);
+			result->sourceSize = entry.archiveFile->uncompressedSize;
+			result->blockParallel = false;
+			return;
+		}
+
+		// A missing (optional) source file, such as a thumb, is skipped
+		if (!statSourceFile(entry.fileNameSource.c_str(), &result->zi, &result->sourceSize))
+		{
+			result->skipped = true;
+			return;
+		}
+		result->blockParallel = mPolicy.getDefaultLevel() != 0 && result->sourceSize > mBlockThreshold;
+
+		// The entry in the previous zip file can be reused if the size, the modification time and the crc
+		// are the same; the crc is checked when the source file is read
+		if (mPreviousZip)
+		{
+			std::map<String, PreviousEntry>::const_iterator it = mPreviousEntries.find(entry.nameInZip);
+			if (it != mPreviousEntries.end() &&
+				it->second.uncompressedSize == result->sourceSize &&
+				it->second.dosDate == getDosDate(result->zi.tmz_date))
+			{
+				result->previous = &it->second;
+			}
+		}
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::compressEntry (const ExportEntry& entry, CompressedEntry* result)
+	{
+		// Executed by a worker thread; the entry is deflated (raw) into the result buffer
+		result->crc = crc32(0L, Z_NULL, 0);
+		result->uncompressedSize = 0;
+		result->compressedSize = 0;
+
+		FILE* fin = NULL;
+		DataStreamPtr archiveStream;
+		if (entry.archiveFile)
+		{
+			archiveStream = entry.archiveFile->archive->open(entry.archiveFile->filename);
+			if (archiveStream.isNull())
+			{
+				result->skipped = true;
+				return;
+			}
+		}
+		else if (!entry.inMemory)
+		{
+			fin = FOPEN_FUNC(entry.fileNameSource.c_str(), "rb");
+			if (fin == NULL)
+			{
+				result->skipped = true;
+				return;
+			}
+		}
+
+		// Check whether the entry of the previous zip file can be reused; if not, start again and compress it
+		if (result->previous)
+		{
+			if (checksumFile(fin, &result->crc) && result->crc == result->previous->crc)
+			{
+				result->reuse = true;
+				fclose(fin);
+				return;
+			}
+			result->crc = crc32(0L, Z_NULL, 0);
+			rewind(fin);
+		}
+
+		z_stream stream;
+		memset(&stream, 0, sizeof(z_stream));
+		bool initialised = false;
+		std::vector<unsigned char> in(WRITEBUFFERSIZE);
+		std::vector<unsigned char> out(WRITEBUFFERSIZE);
+		size_t offset = 0;
+		size_t sizeRead;
+		int flush;
+		do
+		{
+			if (isCancelled())
+			{
+				result->valid = false;
+				result->errorText = "Export cancelled";
+				break;
+			}
+
+			if (entry.inMemory)
+			{
+				sizeRead = std::min(entry.content.size() - offset, (size_t)WRITEBUFFERSIZE);
+				memcpy(&in[0], entry.content.data() + offset, sizeRead);
+				offset += sizeRead;
+				flush = (offset == entry.content.size()) ? Z_FINISH : Z_NO_FLUSH;
+			}
+			else if (entry.archiveFile)
+			{
+				sizeRead = archiveStream->read(&in[0], WRITEBUFFERSIZE);
+				flush = archiveStream->eof() ? Z_FINISH : Z_NO_FLUSH;
+				if (sizeRead == 0 && flush != Z_FINISH)
+				{
+					result->valid = false;
+					result->errorText = "Error reading " + entry.fileNameSource;
+					break;
+				}
+			}
+			else
+			{
+				sizeRead = fread(&in[0], 1, WRITEBUFFERSIZE, fin);
+				if (ferror(fin))
+				{
+					result->valid = false;
+					result->errorText = "Error reading " + entry.fileNameSource;
+					break;
+				}
+				flush = feof(fin) ? Z_FINISH : Z_NO_FLUSH;
+			}
+
+			if (!initialised)
+			{
+				// The compression is chosen from the name and the first bytes of the entry
+				CompressionSettings settings = mPolicy.getSettings(entry.nameInZip, &in[0], sizeRead);
+				result->method = settings.method;
+				result->level = settings.level;
+				if (result->method == Z_DEFLATED &&
+					deflateInit2(&stream, settings.level, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL, settings.strategy) != Z_OK)
+				{
+					result->valid = false;
+					result->errorText = "Error initialising compression of " + entry.nameInZip;
+					break;
+				}
+				initialised = true;
+			}
+
+			result->crc = crc32(result->crc, &in[0], (uInt)sizeRead);
+			result->uncompressedSize += sizeRead;
+			if (result->method != Z_DEFLATED)
+			{
+				result->valid = appendOutput(result, &in[0], sizeRead);
+				continue;
+			}
+
+			stream.next_in = &in[0];
+			stream.avail_in = (uInt)sizeRead;
+			do
+			{
+				stream.next_out = &out[0];
+				stream.avail_out = (uInt)out.size();
+				deflate(&stream, flush);
+				if (!appendOutput(result, &out[0], out.size() - stream.avail_out))
+					result->valid = false;
+			} while (stream.avail_out == 0 && result->valid);
+		} while (flush != Z_FINISH && result->valid);
+
+		if (initialised && result->method == Z_DEFLATED)
+			deflateEnd(&stream);
+		if (fin)
+			fclose(fin);
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipWriter::appendOutput (CompressedEntry* result, const void* buf, size_t len)
+	{
+		if (len == 0)
+			return true;
+
+		// Move the data to a temporary file once the spill threshold is exceeded
+		if (result->spill == NULL && result->data.size() + len > mSpillThreshold)
+		{
+			result->spill = tmpfile();
+			if (result->spill == NULL ||
+				fwrite(result->data.data(), 1, result->data.size(), result->spill) != result->data.size())
+			{
+				result->errorText = "Could not create temporary file";
+				return false;
+			}
+			std::string().swap(result->data);
+		}
+
+		if (result->spill)
+		{
+			if (fwrite(buf, 1, len, result->spill) != len)
+			{
+				result->errorText = "Error writing temporary file";
+				return false;
+			}
+		}
+		else
+		{
+			result->data.append((const char*)buf, len);
+		}
+
+		result->compressedSize += len;
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipWriter::appendEntry (zipFile zf, const ExportEntry& entry, CompressedEntry* result)
+	{
+		// Executed by the calling thread; the compressed data is written as-is (raw) to the zip file
+		if (result->skipped)
+		{
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Skipped " + entry.fileNameSource + "; file cannot be opened");
+			return true;
+		}
+
+		if (!result->valid)
+		{
+			if (!isCancelled())
+				LogManager::getSingleton().logMessage("ProjectImportExportPlugin: " + result->errorText);
+			mErrorText = result->errorText;
+			return false;
+		}
+
+		if (result->reuse)
+			return copyPreviousEntry(zf, entry, result);
+
+		if (!openEntryInZip(zf, entry, result))
+			return false;
+
+		int err = ZIP_OK;
+		if (result->spill)
+		{
+			std::vector<char> buf(WRITEBUFFERSIZE);
+			size_t sizeRead;
+			rewind(result->spill);
+			do
+			{
+				sizeRead = fread(&buf[0], 1, buf.size(), result->spill);
+				if (sizeRead > 0)
+					err = zipWriteInFileInZip(zf, &buf[0], (unsigned)sizeRead);
+			} while (err == ZIP_OK && sizeRead > 0 && !isCancelled());
+			if (ferror(result->spill) || isCancelled())
+				err = ZIP_ERRNO;
+		}
+		else if (!result->data.empty())
+		{
+			err = zipWriteInFileInZip(zf, result->data.data(), (unsigned)result->data.size());
+		}
+
+		if (err < 0)
+		{
+			if (!isCancelled())
+				LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error in writing " + entry.nameInZip + " in zipfile");
+			zipCloseFileInZipRaw64(zf, result->uncompressedSize, result->crc);
+			return false;
+		}
+
+		err = zipCloseFileInZipRaw64(zf, result->uncompressedSize, result->crc);
+		if (err != ZIP_OK)
+		{
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error in closing " + entry.nameInZip + " in zipfile");
+			return false;
+		}
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipWriter::appendBlockParallelEntry (zipFile zf, const ExportEntry& entry, CompressedEntry* result, ProjectThreadPool& pool)
+	{
+		// Executed by the calling thread; the blocks are compressed by the workers and written in order
+		result->crc = crc32(0L, Z_NULL, 0);
+		result->uncompressedSize = result->sourceSize;
+		result->compressedSize = 0;
+
+		size_t numberOfBlocks = (size_t)((result->sourceSize + BLOCK_SIZE - 1) / BLOCK_SIZE);
+		size_t window = 2 * pool.getNumberOfThreads();
+		std::vector<CompressedBlock> blocks(numberOfBlocks);
+		std::vector< std::future<void> > futures(numberOfBlocks);
+		size_t submitted = 0;
+		size_t written = 0;
+
+		// Check whether the entry of the previous zip file can be reused; the crc's of the blocks are calculated in parallel
+		if (result->previous)
+		{
+			CompressionSettings checksumOnly = { -1, 0, 0 };
+			bool valid = true;
+			while (written < numberOfBlocks)
+			{
+				while (submitted < numberOfBlocks && submitted < written + window)
+				{
+					ZPOS64_T offset = (ZPOS64_T)submitted * BLOCK_SIZE;
+					size_t length = (size_t)std::min((ZPOS64_T)BLOCK_SIZE, result->sourceSize - offset);
+					const ExportEntry* source = &entry;
+					CompressedBlock* block = &blocks[submitted];
+					futures[submitted] = pool.submit([this, source, offset, length, checksumOnly, block]() { compressBlock(*source, offset, length, false, checksumOnly, block); });
+					++submitted;
+				}
+
+				futures[written].wait();
+				ZPOS64_T length = std::min((ZPOS64_T)BLOCK_SIZE, result->sourceSize - (ZPOS64_T)written * BLOCK_SIZE);
+				valid = valid && blocks[written].valid;
+				result->crc = crc32_combine64(result->crc, blocks[written].crc, (z_off64_t)length);
+				++written;
+			}
+
+			if (isCancelled())
+				return false;
+
+			if (valid && result->crc == result->previous->crc)
+			{
+				result->reuse = true;
+				if (!copyPreviousEntry(zf, entry, result))
+					return false;
+				if (mProgress)
+					mProgress->addDone(result->sourceSize, 0);
+				return true;
+			}
+
+			result->crc = crc32(0L, Z_NULL, 0);
+			submitted = 0;
+			written = 0;
+		}
+
+		FILE* fin = FOPEN_FUNC(entry.fileNameSource.c_str(), "rb");
+		if (fin == NULL)
+		{
+			result->skipped = true;
+			return appendEntry(zf, entry, result);
+		}
+
+		// The compression is chosen from the name and the first bytes of the entry; all blocks use the same settings
+		std::vector<unsigned char> sample(BLOCK_SIZE);
+		size_t sampleLength = fread(&sample[0], 1, sample.size(), fin);
+		fclose(fin);
+		CompressionSettings settings = mPolicy.getSettings(entry.nameInZip, &sample[0], sampleLength);
+		result->method = settings.method;
+		result->level = settings.level;
+
+		// The compressed size is not known yet, so add the zip64 info with some margin for incompressible data
+		result->compressedSize = result->sourceSize + (result->sourceSize >> 8);
+		if (!openEntryInZip(zf, entry, result))
+			return false;
+
+		int err = ZIP_OK;
+		while (written < numberOfBlocks)
+		{
+			while (submitted < numberOfBlocks && submitted < written + window)
+			{
+				ZPOS64_T offset = (ZPOS64_T)submitted * BLOCK_SIZE;
+				size_t length = (size_t)std::min((ZPOS64_T)BLOCK_SIZE, result->sourceSize - offset);
+				bool last = (submitted + 1 == numberOfBlocks);
+				const ExportEntry* source = &entry;
+				CompressedBlock* block = &blocks[submitted];
+				futures[submitted] = pool.submit([this, source, offset, length, last, settings, block]() { compressBlock(*source, offset, length, last, settings, block); });
+				++submitted;
+			}
+
+			futures[written].wait();
+			CompressedBlock* block = &blocks[written];
+			if (err == ZIP_OK && isCancelled())
+				err = ZIP_ERRNO;
+			if (err == ZIP_OK && !block->valid)
+			{
+				LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error reading " + entry.fileNameSource);
+				err = ZIP_ERRNO;
+			}
+			if (err == ZIP_OK)
+			{
+				// The crc's of the blocks are calculated by the workers; only combine them
+				ZPOS64_T length = std::min((ZPOS64_T)BLOCK_SIZE, result->sourceSize - (ZPOS64_T)written * BLOCK_SIZE);
+				result->crc = crc32_combine64(result->crc, block->crc, (z_off64_t)length);
+				if (!block->data.empty())
+					err = zipWriteInFileInZip(zf, block->data.data(), (unsigned)block->data.size());
+				if (err == ZIP_OK && mProgress)
+					mProgress->addDone(length, 0);
+			}
+			std::string().swap(block->data);
+			++written;
+
+			// In case of an error, only wait for the submitted tasks to finish
+			if (err != ZIP_OK)
+				numberOfBlocks = submitted;
+		}
+
+		if (err != ZIP_OK)
+		{
+			if (!isCancelled())
+				LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error in writing " + entry.nameInZip + " in zipfile");
+			zipCloseFileInZipRaw64(zf, result->uncompressedSize, result->crc);
+			return false;
+		}
+
+		err = zipCloseFileInZipRaw64(zf, result->uncompressedSize, result->crc);
+		if (err != ZIP_OK)
+		{
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error in closing " + entry.nameInZip + " in zipfile");
+			return false;
+		}
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::compressBlock (const ExportEntry& entry, ZPOS64_T offset, size_t length, bool last,
+		const CompressionSettings& settings, CompressedBlock* result)
+	{
+		// Executed by a worker thread. The last 32K of the previous block is used as dictionary, so matches
+		// across the block boundary are not lost. Each block, except the last, ends with a sync flush, which
+		// aligns the output on a byte boundary; the blocks can then be concatenated into one deflate stream.
+		result->valid = false;
+		result->crc = crc32(0L, Z_NULL, 0);
+		if (isCancelled())
+			return;
+
+		FILE* fin = FOPEN_FUNC(entry.fileNameSource.c_str(), "rb");
+		if (fin == NULL)
+			return;
+
+		size_t dictionaryLength = (settings.method == Z_DEFLATED) ? (size_t)std::min((ZPOS64_T)DICTIONARY_SIZE, offset) : 0;
+		std::vector<unsigned char> in(dictionaryLength + length);
+		if (FSEEKO_FUNC(fin, offset - dictionaryLength, SEEK_SET) != 0 ||
+			fread(&in[0], 1, in.size(), fin) != in.size())
+		{
+			fclose(fin);
+			return;
+		}
+		fclose(fin);
+
+		result->crc = crc32(result->crc, &in[dictionaryLength], (uInt)length);
+		if (settings.method < 0)
+		{
+			// Only the crc is needed
+			result->valid = true;
+			return;
+		}
+		else if (settings.method != Z_DEFLATED)
+		{
+			// Stored; the block is copied as-is
+			result->data.assign((const char*)&in[0], length);
+			result->valid = true;
+			return;
+		}
+
+		z_stream stream;
+		memset(&stream, 0, sizeof(z_stream));
+		if (deflateInit2(&stream, settings.level, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL, settings.strategy) != Z_OK)
+			return;
+		if (dictionaryLength > 0 && deflateSetDictionary(&stream, &in[0], (uInt)dictionaryLength) != Z_OK)
+		{
+			deflateEnd(&stream);
+			return;
+		}
+
+		result->data.resize(deflateBound(&stream, (uLong)length) + 64);
+		stream.next_in = &in[dictionaryLength];
+		stream.avail_in = (uInt)length;
+		stream.next_out = (Bytef*)&result->data[0];
+		stream.avail_out = (uInt)result->data.size();
+		int err = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+		result->data.resize(stream.total_out);
+		deflateEnd(&stream);
+
+		// The output buffer is large enough for the whole block; if it is full, the flush may be incomplete
+		result->valid = (err == (last ? Z_STREAM_END : Z_OK)) && stream.avail_in == 0 && stream.avail_out > 0;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipWriter::openEntryInZip (zipFile zf, const ExportEntry& entry, CompressedEntry* result)
+	{
+		// The path name saved, should not include a leading slash.
+		// If it did, windows/xp and dynazip couldn't read the zip file.
+		const char* nameInZip = entry.nameInZip.c_str();
+		while (nameInZip[0] == '\\' || nameInZip[0] == '/')
+		{
+			nameInZip++;
+		}
+
+		int zip64 = (result->uncompressedSize >= 0xffffffff || result->compressedSize >= 0xffffffff) ? 1 : 0;
+		int err = zipOpenNewFileInZip2_64(zf, nameInZip, &result->zi,
+			NULL, 0, NULL, 0, NULL /* comment*/,
+			result->method, result->level, 1, zip64);
+		if (err != ZIP_OK)
+		{
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error adding " + entry.nameInZip + " to zipfile");
+			return false;
+		}
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::releaseEntry (CompressedEntry* result)
+	{
+		std::string().swap(result->data);
+		if (result->spill)
+		{
+			fclose(result->spill);
+			result->spill = NULL;
+		}
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipWriter::statSourceFile (const char* fileName, zip_fileinfo* zi, ZPOS64_T* size)
+	{
+		// Use the modification time of the source file; entries created in memory get the current time
+		memset(zi, 0, sizeof(zip_fileinfo));
+		*size = 0;
+		time_t t = time(NULL);
+		if (fileName)
+		{
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+			struct _stat64 st;
+			if (_stat64(fileName, &st) != 0)
+				return false;
+#else
+			struct stat st;
+			if (stat(fileName, &st) != 0)
+				return false;
+#endif
+			t = st.st_mtime;
+			*size = st.st_size;
+		}
+
+		struct tm filedate;
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+		if (localtime_s(&filedate, &t) != 0)
+			return true;
+#else
+		if (localtime_r(&t, &filedate) == NULL)
+			return true;
+#endif
+		zi->tmz_date.tm_sec = filedate.tm_sec;
+		zi->tmz_date.tm_min = filedate.tm_min;
+		zi->tmz_date.tm_hour = filedate.tm_hour;
+		zi->tmz_date.tm_mday = filedate.tm_mday;
+		zi->tmz_date.tm_mon = filedate.tm_mon;
+		zi->tmz_date.tm_year = filedate.tm_year;
+		return true;
+	}
+	//---------------------------------------------------------------------
+	uLong ProjectZipWriter::getDosDate (const tm_zip& date)
+	{
+		// Same conversion as minizip uses when it writes the date of an entry
+		uLong year = (uLong)date.tm_year;
+		if (year >= 1980)
+			year -= 1980;
+		else if (year >= 80)
+			year -= 80;
+		return (uLong)(((date.tm_mday) + (32 * (date.tm_mon + 1)) + (512 * year)) << 16) |
+			((date.tm_sec / 2) + (32 * date.tm_min) + (2048 * (uLong)date.tm_hour));
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipWriter::checksumFile (FILE* fin, uLong* crc)
+	{
+		std::vector<unsigned char> buf(WRITEBUFFERSIZE);
+		size_t sizeRead;
+		do
+		{
+			sizeRead = fread(&buf[0], 1, buf.size(), fin);
+			*crc = crc32(*crc, &buf[0], (uInt)sizeRead);
+		} while (sizeRead > 0 && !isCancelled());
+
+		return ferror(fin) == 0 && !isCancelled();
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::openPreviousArchive (const String& zipName)
+	{
+		// Index all entries of the previous version of the zip file, if it exists
+		mPreviousEntries.clear();
+		mPreviousZip = ProjectZipReader::openZipFile(zipName);
+		if (mPreviousZip == NULL)
+			return;
+
+		char fileName[MAX_FILENAME];
+		unz_file_info64 fileInfo;
+		PreviousEntry previous;
+		int err = unzGoToFirstFile(mPreviousZip);
+		while (err == UNZ_OK)
+		{
+			if (unzGetCurrentFileInfo64(mPreviousZip, &fileInfo, fileName, MAX_FILENAME, NULL, 0, NULL, 0) != UNZ_OK ||
+				unzGetFilePos64(mPreviousZip, &previous.position) != UNZ_OK)
+				break;
+
+			previous.crc = fileInfo.crc;
+			previous.uncompressedSize = fileInfo.uncompressed_size;
+			previous.compressedSize = fileInfo.compressed_size;
+			previous.dosDate = fileInfo.dosDate;
+			mPreviousEntries[fileName] = previous;
+			err = unzGoToNextFile(mPreviousZip);
+		}
+
+		if (err != UNZ_END_OF_LIST_OF_FILE)
+		{
+			// Do not trust a damaged zip file
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Cannot reuse " + zipName);
+			closePreviousArchive();
+			return;
+		}
+
+		LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Reusing unchanged entries of " + zipName);
+	}
+	//---------------------------------------------------------------------
+	void ProjectZipWriter::closePreviousArchive (void)
+	{
+		if (mPreviousZip)
+			unzClose(mPreviousZip);
+		mPreviousZip = NULL;
+		mPreviousEntries.clear();
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipWriter::copyPreviousEntry (zipFile zf, const ExportEntry& entry, CompressedEntry* result)
+	{
+		// Executed by the calling thread; the compressed data of the previous zip file is copied as-is (raw)
+		const PreviousEntry* previous = result->previous;
+		int method;
+		int level;
+		unz64_file_pos position = previous->position;
+		if (unzGoToFilePos64(mPreviousZip, &position) != UNZ_OK ||
+			unzOpenCurrentFile2(mPreviousZip, &method, &level, 1) != UNZ_OK)
+		{
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error reading " + entry.nameInZip + " from the previous zipfile");
+			return false;
+		}
+
+		result->method = method;
+		result->level = level;
+		result->crc = previous->crc;
+		result->uncompressedSize = previous->uncompressedSize;
+		result->compressedSize = previous->compressedSize;
+		result->zi.dosDate = previous->dosDate;
+		if (!openEntryInZip(zf, entry, result))
+		{
+			unzCloseCurrentFile(mPreviousZip);
+			return false;
+		}
+
+		std::vector<char> buf(WRITEBUFFERSIZE);
+		int sizeRead;
+		int err = ZIP_OK;
+		do
+		{
+			sizeRead = unzReadCurrentFile(mPreviousZip, &buf[0], (unsigned)buf.size());
+			if (sizeRead < 0)
+				err = ZIP_ERRNO;
+			else if (sizeRead > 0)
+				err = zipWriteInFileInZip(zf, &buf[0], (unsigned)sizeRead);
+		} while (err == ZIP_OK && sizeRead > 0 && !isCancelled());
+		unzCloseCurrentFile(mPreviousZip);
+		if (isCancelled())
+			err = ZIP_ERRNO;
+
+		if (err != ZIP_OK)
+		{
+			if (!isCancelled())
+				LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error in writing " + entry.nameInZip + " in zipfile");
+			zipCloseFileInZipRaw64(zf, result->uncompressedSize, result->crc);
+			return false;
+		}
+
+		err = zipCloseFileInZipRaw64(zf, result->uncompressedSize, result->crc);
+		if (err != ZIP_OK)
+		{
+			LogManager::getSingleton().logMessage("ProjectImportExportPlugin: Error in closing " + entry.nameInZip + " in zipfile");
+			return false;
+		}
+
+		return true;
+	}
+	//---------------------------------------------------------------------
+	bool ProjectZipWriter::isCancelled (void) const
+	{
+		return mProgress && mProgress->isCancelled();
+	}
+}
@@ -158,6 +158,8 @@ typedef struct zlib_filefunc_def_s
 typedef ZPOS64_T (ZCALLBACK *tell64_file_func)    OF((voidpf opaque, voidpf stream));
 typedef long     (ZCALLBACK *seek64_file_func)    OF((voidpf opaque, voidpf stream, ZPOS64_T offset, int origin));
 typedef voidpf   (ZCALLBACK *open64_file_func)    OF((voidpf opaque, const void* filename, int mode));
+/* optional: returns a read-only view of the whole opened file and its size, or NULL if the file is not mapped */
+typedef const void* (ZCALLBACK *map64_file_func)  OF((voidpf opaque, voidpf stream, ZPOS64_T* size));
 
 typedef struct zlib_filefunc64_def_s
 {
@@ -169,6 +171,7 @@ typedef struct zlib_filefunc64_def_s
     close_file_func     zclose_file;
     testerror_file_func zerror_file;
     voidpf              opaque;
+    map64_file_func     zmap64_file;
 } zlib_filefunc64_def;
 
 void fill_fopen64_filefunc OF((zlib_filefunc64_def* pzlib_filefunc_def));
@@ -194,12 +197,14 @@ typedef struct zlib_filefunc64_32_def_s
 voidpf call_zopen64 OF((const zlib_filefunc64_32_def* pfilefunc,const void*filename,int mode));
 long    call_zseek64 OF((const zlib_filefunc64_32_def* pfilefunc,voidpf filestream, ZPOS64_T offset, int origin));
 ZPOS64_T call_ztell64 OF((const zlib_filefunc64_32_def* pfilefunc,voidpf filestream));
+const void* call_zmap64 OF((const zlib_filefunc64_32_def* pfilefunc,voidpf filestream, ZPOS64_T* size));
 
 void    fill_zlib_filefunc64_32_def_from_filefunc32(zlib_filefunc64_32_def* p_filefunc64_32,const zlib_filefunc_def* p_filefunc32);
 
 #define ZOPEN64(filefunc,filename,mode)         (call_zopen64((&(filefunc)),(filename),(mode)))
 #define ZTELL64(filefunc,filestream)            (call_ztell64((&(filefunc)),(filestream)))
 #define ZSEEK64(filefunc,filestream,pos,mode)   (call_zseek64((&(filefunc)),(filestream),(pos),(mode)))
+#define ZMAP64(filefunc,filestream,size)        (call_zmap64((&(filefunc)),(filestream),(size)))
 
 #ifdef __cplusplus
 }
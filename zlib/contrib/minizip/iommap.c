@@ -0,0 +1,204 @@
+/* iommap.c -- memory mapped IO functions for reading .zip files
+     Follows the ioapi interface of the MiniZip project
+
+     For more info read MiniZip_info.txt
+
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "zlib.h"
+#include "ioapi.h"
+#include "iommap.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+typedef struct
+{
+    const unsigned char* base;
+    ZPOS64_T size;
+    ZPOS64_T position;
+} MMAP_FILE_STREAM;
+
+static voidpf      ZCALLBACK mmap_open64_file_func OF((voidpf opaque, const void* filename, int mode));
+static uLong       ZCALLBACK mmap_read_file_func   OF((voidpf opaque, voidpf stream, void* buf, uLong size));
+static uLong       ZCALLBACK mmap_write_file_func  OF((voidpf opaque, voidpf stream, const void* buf, uLong size));
+static ZPOS64_T    ZCALLBACK mmap_tell64_file_func OF((voidpf opaque, voidpf stream));
+static long        ZCALLBACK mmap_seek64_file_func OF((voidpf opaque, voidpf stream, ZPOS64_T offset, int origin));
+static int         ZCALLBACK mmap_close_file_func  OF((voidpf opaque, voidpf stream));
+static int         ZCALLBACK mmap_error_file_func  OF((voidpf opaque, voidpf stream));
+static const void* ZCALLBACK mmap_map64_file_func  OF((voidpf opaque, voidpf stream, ZPOS64_T* size));
+
+/* Maps the whole file; the file (and mapping) handles are closed again, the view keeps the file open */
+static const unsigned char* mmap_map_file (const char* filename, ZPOS64_T* size)
+{
+#ifdef _WIN32
+    HANDLE hFile;
+    HANDLE hMapping;
+    LARGE_INTEGER fileSize;
+    const unsigned char* base = NULL;
+
+    hFile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0 && (ZPOS64_T)fileSize.QuadPart <= (ZPOS64_T)((size_t)-1))
+    {
+        hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (hMapping != NULL)
+        {
+            base = (const unsigned char*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(hMapping);
+        }
+    }
+    CloseHandle(hFile);
+
+    if (base != NULL)
+        *size = (ZPOS64_T)fileSize.QuadPart;
+    return base;
+#else
+    int fd;
+    struct stat st;
+    void* base = NULL;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (ZPOS64_T)st.st_size <= (ZPOS64_T)((size_t)-1))
+    {
+        base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED)
+            base = NULL;
+    }
+    close(fd);
+
+    if (base != NULL)
+        *size = (ZPOS64_T)st.st_size;
+    return (const unsigned char*)base;
+#endif
+}
+
+static voidpf ZCALLBACK mmap_open64_file_func (voidpf opaque, const void* filename, int mode)
+{
+    MMAP_FILE_STREAM* s;
+    ZPOS64_T size = 0;
+    const unsigned char* base;
+
+    /* read-only */
+    if ((filename == NULL) || ((mode & ZLIB_FILEFUNC_MODE_READWRITEFILTER) != ZLIB_FILEFUNC_MODE_READ))
+        return NULL;
+
+    base = mmap_map_file((const char*)filename, &size);
+    if (base == NULL)
+        return NULL;
+
+    s = (MMAP_FILE_STREAM*)malloc(sizeof(MMAP_FILE_STREAM));
+    if (s == NULL)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(base);
+#else
+        munmap((void*)base, (size_t)size);
+#endif
+        return NULL;
+    }
+
+    s->base = base;
+    s->size = size;
+    s->position = 0;
+    return s;
+}
+
+static uLong ZCALLBACK mmap_read_file_func (voidpf opaque, voidpf stream, void* buf, uLong size)
+{
+    MMAP_FILE_STREAM* s = (MMAP_FILE_STREAM*)stream;
+    uLong ret = size;
+
+    if (s->position >= s->size)
+        return 0;
+    if ((ZPOS64_T)ret > s->size - s->position)
+        ret = (uLong)(s->size - s->position);
+
+    memcpy(buf, s->base + s->position, ret);
+    s->position += ret;
+    return ret;
+}
+
+static uLong ZCALLBACK mmap_write_file_func (voidpf opaque, voidpf stream, const void* buf, uLong size)
+{
+    return 0;
+}
+
+static ZPOS64_T ZCALLBACK mmap_tell64_file_func (voidpf opaque, voidpf stream)
+{
+    return ((MMAP_FILE_STREAM*)stream)->position;
+}
+
+static long ZCALLBACK mmap_seek64_file_func (voidpf opaque, voidpf stream, ZPOS64_T offset, int origin)
+{
+    MMAP_FILE_STREAM* s = (MMAP_FILE_STREAM*)stream;
+
+    switch (origin)
+    {
+    case ZLIB_FILEFUNC_SEEK_CUR :
+        s->position += offset;
+        break;
+    case ZLIB_FILEFUNC_SEEK_END :
+        s->position = s->size + offset;
+        break;
+    case ZLIB_FILEFUNC_SEEK_SET :
+        s->position = offset;
+        break;
+    default: return -1;
+    }
+    return 0;
+}
+
+static int ZCALLBACK mmap_close_file_func (voidpf opaque, voidpf stream)
+{
+    MMAP_FILE_STREAM* s = (MMAP_FILE_STREAM*)stream;
+
+#ifdef _WIN32
+    UnmapViewOfFile(s->base);
+#else
+    munmap((void*)s->base, (size_t)s->size);
+#endif
+    free(s);
+    return 0;
+}
+
+static int ZCALLBACK mmap_error_file_func (voidpf opaque, voidpf stream)
+{
+    return 0;
+}
+
+static const void* ZCALLBACK mmap_map64_file_func (voidpf opaque, voidpf stream, ZPOS64_T* size)
+{
+    MMAP_FILE_STREAM* s = (MMAP_FILE_STREAM*)stream;
+
+    *size = s->size;
+    return s->base;
+}
+
+void fill_mmap_filefunc64 (zlib_filefunc64_def* pzlib_filefunc_def)
+{
+    pzlib_filefunc_def->zopen64_file = mmap_open64_file_func;
+    pzlib_filefunc_def->zread_file = mmap_read_file_func;
+    pzlib_filefunc_def->zwrite_file = mmap_write_file_func;
+    pzlib_filefunc_def->ztell64_file = mmap_tell64_file_func;
+    pzlib_filefunc_def->zseek64_file = mmap_seek64_file_func;
+    pzlib_filefunc_def->zclose_file = mmap_close_file_func;
+    pzlib_filefunc_def->zerror_file = mmap_error_file_func;
+    pzlib_filefunc_def->opaque = NULL;
+    pzlib_filefunc_def->zmap64_file = mmap_map64_file_func;
+}
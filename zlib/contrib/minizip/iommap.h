@@ -0,0 +1,28 @@
+/* iommap.h -- memory mapped IO function header for reading .zip files
+     Follows the ioapi interface of the MiniZip project
+
+     The whole file is mapped read-only when it is opened; unzip uses the view (see zmap64_file in
+     ioapi.h) to inflate entries straight from the mapped archive, without seeking, reading and copying
+     per buffer. Files opened for writing and files that cannot be mapped (for example empty files)
+     fail to open, so the caller can fall back to the default IO functions.
+
+     For more info read MiniZip_info.txt
+
+*/
+
+#ifndef _IOMMAP_H
+#define _IOMMAP_H
+
+#include "ioapi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void fill_mmap_filefunc64 OF((zlib_filefunc64_def* pzlib_filefunc_def));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -104,6 +104,11 @@
 #define UNZ_BUFSIZE (16384)
 #endif
 
+/* largest part of a mapped entry handed to inflate at once (avail_in is an uInt) */
+#ifndef UNZ_MAPPEDINSIZE
+#define UNZ_MAPPEDINSIZE (0x40000000)
+#endif
+
 #ifndef UNZ_MAXFILENAMEINZIP
 #define UNZ_MAXFILENAMEINZIP (256)
 #endif
@@ -157,6 +162,8 @@ typedef struct
     uLong compression_method;   /* compression method (0==store) */
     ZPOS64_T byte_before_the_zipfile;/* byte before the zipfile, (>0 for sfx)*/
     int   raw;
+    const unsigned char* mapped_file; /* view of the whole zipfile, or NULL */
+    ZPOS64_T mapped_size;
 } file_in_zip64_read_info_s;
 
 
@@ -167,6 +174,8 @@ typedef struct
     zlib_filefunc64_32_def z_filefunc;
     int is64bitOpenFunction;
     voidpf filestream;        /* io structore of the zipfile */
+    const unsigned char* mapped_file; /* view of the whole zipfile if the io functions map it, or NULL */
+    ZPOS64_T mapped_size;
     unz_global_info64 gi;       /* public global information */
     ZPOS64_T byte_before_the_zipfile;/* byte before the zipfile, (>0 for sfx)*/
     ZPOS64_T num_file;             /* number of the current file in the zipfile*/
@@ -620,6 +629,9 @@ local unzFile unzOpenInternal (const void *path,
     if (us.filestream==NULL)
         return NULL;
 
+    us.mapped_size = 0;
+    us.mapped_file = (const unsigned char*)ZMAP64(us.z_filefunc, us.filestream, &us.mapped_size);
+
     central_pos = unz64local_SearchCentralDir64(&us.z_filefunc,us.filestream);
     if (central_pos)
     {
@@ -1544,6 +1556,8 @@ extern int ZEXPORT unzOpenCurrentFile3 (unzFile file, int* method,
     pfile_in_zip_read_info->filestream=s->filestream;
     pfile_in_zip_read_info->z_filefunc=s->z_filefunc;
     pfile_in_zip_read_info->byte_before_the_zipfile=s->byte_before_the_zipfile;
+    pfile_in_zip_read_info->mapped_file=s->mapped_file;
+    pfile_in_zip_read_info->mapped_size=s->mapped_size;
 
     pfile_in_zip_read_info->stream.total_out = 0;
 
@@ -1583,7 +1597,11 @@ extern int ZEXPORT unzOpenCurrentFile3 (unzFile file, int* method,
 
       err=inflateInit2(&pfile_in_zip_read_info->stream, -MAX_WBITS);
       if (err == Z_OK)
+      {
+        /* inflate computes the crc while it copies the output (cannot fail on a new raw stream) */
+        inflateRawCrc32(&pfile_in_zip_read_info->stream, 1);
         pfile_in_zip_read_info->stream_initialised=Z_DEFLATED;
+      }
       else
       {
         TRYFREE(pfile_in_zip_read_info);
@@ -1719,6 +1737,29 @@ extern int ZEXPORT unzReadCurrentFile  (unzFile file, voidp buf, unsigned len)
 
     while (pfile_in_zip_read_info->stream.avail_out>0)
     {
+        if ((pfile_in_zip_read_info->stream.avail_in==0) &&
+            (pfile_in_zip_read_info->rest_read_compressed>0) &&
+            (pfile_in_zip_read_info->mapped_file!=NULL) &&
+            (!s->encrypted) &&
+            (pfile_in_zip_read_info->pos_in_zipfile +
+                pfile_in_zip_read_info->byte_before_the_zipfile +
+                pfile_in_zip_read_info->rest_read_compressed <= pfile_in_zip_read_info->mapped_size))
+        {
+            /* the zipfile is mapped: point next_in straight at the entry, without seek, read and copy */
+            uInt uReadThis = UNZ_MAPPEDINSIZE;
+            if (pfile_in_zip_read_info->rest_read_compressed<uReadThis)
+                uReadThis = (uInt)pfile_in_zip_read_info->rest_read_compressed;
+
+            pfile_in_zip_read_info->stream.next_in =
+                (Bytef*)(pfile_in_zip_read_info->mapped_file +
+                         pfile_in_zip_read_info->pos_in_zipfile +
+                         pfile_in_zip_read_info->byte_before_the_zipfile);
+            pfile_in_zip_read_info->stream.avail_in = uReadThis;
+
+            pfile_in_zip_read_info->pos_in_zipfile += uReadThis;
+            pfile_in_zip_read_info->rest_read_compressed-=uReadThis;
+        }
+
         if ((pfile_in_zip_read_info->stream.avail_in==0) &&
             (pfile_in_zip_read_info->rest_read_compressed>0))
         {
@@ -1763,7 +1804,7 @@ extern int ZEXPORT unzReadCurrentFile  (unzFile file, voidp buf, unsigned len)
 
         if ((pfile_in_zip_read_info->compression_method==0) || (pfile_in_zip_read_info->raw))
         {
-            uInt uDoCopy,i ;
+            uInt uDoCopy;
 
             if ((pfile_in_zip_read_info->stream.avail_in == 0) &&
                 (pfile_in_zip_read_info->rest_read_compressed == 0))
@@ -1775,15 +1816,16 @@ extern int ZEXPORT unzReadCurrentFile  (unzFile file, voidp buf, unsigned len)
             else
                 uDoCopy = pfile_in_zip_read_info->stream.avail_in ;
 
-            for (i=0;i<uDoCopy;i++)
-                *(pfile_in_zip_read_info->stream.next_out+i) =
-                        *(pfile_in_zip_read_info->stream.next_in+i);
+            memcpy(pfile_in_zip_read_info->stream.next_out,
+                   pfile_in_zip_read_info->stream.next_in, uDoCopy);
 
             pfile_in_zip_read_info->total_out_64 = pfile_in_zip_read_info->total_out_64 + uDoCopy;
 
-            pfile_in_zip_read_info->crc32 = crc32(pfile_in_zip_read_info->crc32,
-                                pfile_in_zip_read_info->stream.next_out,
-                                uDoCopy);
+            /* in raw mode the data is still compressed; its crc is never checked */
+            if (!pfile_in_zip_read_info->raw)
+                pfile_in_zip_read_info->crc32 = crc32(pfile_in_zip_read_info->crc32,
+                                    pfile_in_zip_read_info->stream.next_out,
+                                    uDoCopy);
             pfile_in_zip_read_info->rest_read_uncompressed-=uDoCopy;
             pfile_in_zip_read_info->stream.avail_in -= uDoCopy;
             pfile_in_zip_read_info->stream.avail_out -= uDoCopy;
@@ -1838,19 +1880,18 @@ extern int ZEXPORT unzReadCurrentFile  (unzFile file, voidp buf, unsigned len)
         else
         {
             ZPOS64_T uTotalOutBefore,uTotalOutAfter;
-            const Bytef *bufBefore;
             ZPOS64_T uOutThis;
             int flush=Z_SYNC_FLUSH;
 
             uTotalOutBefore = pfile_in_zip_read_info->stream.total_out;
-            bufBefore = pfile_in_zip_read_info->stream.next_out;
 
-            /*
+            /* all remaining input is available and the output buffer takes all remaining output: when this is the
+               first call (the zipfile is mapped and the caller reads the whole entry), inflate finishes without
+               allocating and updating its window */
             if ((pfile_in_zip_read_info->rest_read_uncompressed ==
                      pfile_in_zip_read_info->stream.avail_out) &&
                 (pfile_in_zip_read_info->rest_read_compressed == 0))
                 flush = Z_FINISH;
-            */
             err=inflate(&pfile_in_zip_read_info->stream,flush);
 
             if ((err>=0) && (pfile_in_zip_read_info->stream.msg!=NULL))
@@ -1861,9 +1902,7 @@ extern int ZEXPORT unzReadCurrentFile  (unzFile file, voidp buf, unsigned len)
 
             pfile_in_zip_read_info->total_out_64 = pfile_in_zip_read_info->total_out_64 + uOutThis;
 
-            pfile_in_zip_read_info->crc32 =
-                crc32(pfile_in_zip_read_info->crc32,bufBefore,
-                        (uInt)(uOutThis));
+            pfile_in_zip_read_info->crc32 = pfile_in_zip_read_info->stream.adler;
 
             pfile_in_zip_read_info->rest_read_uncompressed -=
                 uOutThis;
@@ -1221,7 +1221,11 @@ extern int ZEXPORT zipOpenNewFileInZip4_64 (zipFile file, const char* filename,
           err = deflateInit2(&zi->ci.stream, level, Z_DEFLATED, windowBits, memLevel, strategy);
 
           if (err==Z_OK)
+          {
+              /* deflate computes the crc while it copies the input (cannot fail on a new raw stream) */
+              deflateRawCrc32(&zi->ci.stream, 1);
               zi->ci.stream_initialised = Z_DEFLATED;
+          }
         }
         else if(zi->ci.method == Z_BZIP2ED)
         {
@@ -1411,7 +1415,10 @@ extern int ZEXPORT zipWriteInFileInZip (zipFile file,const void* buf,unsigned in
     if (zi->in_opened_file_inzip == 0)
         return ZIP_PARAMERROR;
 
-    zi->ci.crc32 = crc32(zi->ci.crc32,buf,(uInt)len);
+    /* in raw mode the caller supplies the crc of the uncompressed data to zipCloseFileInZipRaw;
+       deflate computes it itself (see zipOpenNewFileInZip4_64) */
+    if ((!zi->ci.raw) && (zi->ci.method != Z_DEFLATED))
+        zi->ci.crc32 = crc32(zi->ci.crc32,buf,(uInt)len);
 
 #ifdef HAVE_BZIP2
     if(zi->ci.method == Z_BZIP2ED && (!zi->ci.raw))
@@ -1481,15 +1488,13 @@ extern int ZEXPORT zipWriteInFileInZip (zipFile file,const void* buf,unsigned in
           }
           else
           {
-              uInt copy_this,i;
+              uInt copy_this;
               if (zi->ci.stream.avail_in < zi->ci.stream.avail_out)
                   copy_this = zi->ci.stream.avail_in;
               else
                   copy_this = zi->ci.stream.avail_out;
 
-              for (i = 0; i < copy_this; i++)
-                  *(((char*)zi->ci.stream.next_out)+i) =
-                      *(((const char*)zi->ci.stream.next_in)+i);
+              memcpy(zi->ci.stream.next_out, zi->ci.stream.next_in, copy_this);
               {
                   zi->ci.stream.avail_in -= copy_this;
                   zi->ci.stream.avail_out-= copy_this;
@@ -1501,6 +1506,9 @@ extern int ZEXPORT zipWriteInFileInZip (zipFile file,const void* buf,unsigned in
               }
           }
       }// while(...)
+
+      if ((zi->ci.method == Z_DEFLATED) && (!zi->ci.raw))
+          zi->ci.crc32 = zi->ci.stream.adler;
     }
 
     return err;
@@ -0,0 +1,99 @@
+/* cpu_features.c -- run-time detection of the cpu features used by zlib
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+#include "cpu_features.h"
+
+#ifdef X86_CPU_FEATURES
+#  ifdef _MSC_VER
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#endif
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#endif
+
+int ZLIB_INTERNAL x86_cpu_has_sse2 = 0;
+int ZLIB_INTERNAL x86_cpu_has_pclmulqdq = 0;
+int ZLIB_INTERNAL x86_cpu_has_sse42 = 0;
+int ZLIB_INTERNAL x86_cpu_has_avx2 = 0;
+
+local void check_features OF((void));
+
+/* ========================================================================= */
+local void check_features()
+{
+#ifdef X86_CPU_FEATURES
+    unsigned regs[4];   /* eax, ebx, ecx, edx */
+    unsigned max_leaf;
+    unsigned xcr0 = 0;
+    int has_avx;
+
+#  ifdef _MSC_VER
+    __cpuid((int *)regs, 0);
+#  else
+    __cpuid(0, regs[0], regs[1], regs[2], regs[3]);
+#  endif
+    max_leaf = regs[0];
+    if (max_leaf < 1)
+        return;
+
+#  ifdef _MSC_VER
+    __cpuid((int *)regs, 1);
+#  else
+    __cpuid(1, regs[0], regs[1], regs[2], regs[3]);
+#  endif
+    x86_cpu_has_sse2 = (regs[3] >> 26) & 1;
+    x86_cpu_has_pclmulqdq = (regs[2] >> 1) & 1;
+    x86_cpu_has_sse42 = (regs[2] >> 20) & 1;
+
+    /* AVX needs the OS to save the ymm registers (XCR0 bits 1 and 2) */
+    has_avx = (regs[2] >> 28) & 1;
+    if (has_avx && ((regs[2] >> 27) & 1)) {
+#  ifdef _MSC_VER
+        xcr0 = (unsigned)_xgetbv(0);
+#  else
+        __asm__ __volatile__ ("xgetbv" : "=a" (xcr0) : "c" (0) : "edx");
+#  endif
+    }
+    if (!has_avx || (xcr0 & 6) != 6 || max_leaf < 7)
+        return;
+
+#  ifdef _MSC_VER
+    __cpuidex((int *)regs, 7, 0);
+#  else
+    __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#  endif
+    x86_cpu_has_avx2 = (regs[1] >> 5) & 1;
+#endif /* X86_CPU_FEATURES */
+}
+
+#if defined(_WIN32)
+local INIT_ONCE features_once = INIT_ONCE_STATIC_INIT;
+
+local BOOL CALLBACK check_features_once(INIT_ONCE *once, PVOID param,
+                                        PVOID *context)
+{
+    check_features();
+    return TRUE;
+}
+
+/* ========================================================================= */
+void ZLIB_INTERNAL cpu_check_features()
+{
+    InitOnceExecuteOnce(&features_once, check_features_once, NULL, NULL);
+}
+#else
+local pthread_once_t features_once = PTHREAD_ONCE_INIT;
+
+/* ========================================================================= */
+void ZLIB_INTERNAL cpu_check_features()
+{
+    pthread_once(&features_once, check_features);
+}
+#endif
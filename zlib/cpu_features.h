@@ -0,0 +1,40 @@
+/* cpu_features.h -- run-time detection of the cpu features used by zlib
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/* WARNING: this file should *not* be used by applications. It is
+   part of the implementation of the compression library and is
+   subject to change. Applications should only use zlib.h.
+ */
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include "zutil.h"
+
+#if !defined(NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || \
+                          defined(__i386__) || defined(_M_IX86))
+#  define X86_CPU_FEATURES
+#endif
+
+/* The SIMD code is built with per-function target attributes instead of
+   enabling the instructions for whole files, which needs gcc 4.9, clang 3.8
+   or Visual C++ */
+#if defined(X86_CPU_FEATURES) && \
+    (defined(_MSC_VER) || defined(__clang__) || \
+     (defined(__GNUC__) && (__GNUC__ > 4 || \
+                            (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#  define X86_TARGET_ATTRIBUTES
+#endif
+
+/* The flags are valid after cpu_check_features() returned; the features
+   are detected once, by the first call, also when zlib is used by several
+   threads at the same time. */
+extern int ZLIB_INTERNAL x86_cpu_has_sse2;
+extern int ZLIB_INTERNAL x86_cpu_has_pclmulqdq;
+extern int ZLIB_INTERNAL x86_cpu_has_sse42;
+extern int ZLIB_INTERNAL x86_cpu_has_avx2;      /* and the OS saves ymm */
+
+void ZLIB_INTERNAL cpu_check_features OF((void));
+
+#endif /* CPU_FEATURES_H */
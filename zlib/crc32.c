@@ -29,6 +29,7 @@
 #endif /* MAKECRCH */
 
 #include "zutil.h"      /* for STDC and FAR definitions */
+#include "crc32_simd.h"
 
 /* Definitions for doing the crc four data bytes at a time. */
 #if !defined(NOBYFOUR) && defined(Z_U4)
@@ -40,9 +41,12 @@
    local unsigned long crc32_big OF((unsigned long,
                         const unsigned char FAR *, z_size_t));
 #  define TBLS 8
+#  define SLICES 16
 #else
 #  define TBLS 1
 #endif /* BYFOUR */
+local unsigned long crc32_bytewise OF((unsigned long,
+                        const unsigned char FAR *, z_size_t));
 
 /* Local functions for crc concatenation */
 local unsigned long gf2_matrix_times OF((unsigned long *mat,
@@ -55,6 +59,9 @@ local uLong crc32_combine_ OF((uLong crc1, uLong crc2, z_off64_t len2));
 
 local volatile int crc_table_empty = 1;
 local z_crc_t FAR crc_table[TBLS][256];
+#ifdef BYFOUR
+local z_crc_t FAR crc_slice_table[SLICES][256];
+#endif /* BYFOUR */
 local void make_crc_table OF((void));
 #ifdef MAKECRCH
    local void write_table OF((FILE *, const z_crc_t FAR *));
@@ -83,7 +90,9 @@ local void make_crc_table OF((void));
   all the information needed to generate CRCs on data a byte at a time for all
   combinations of CRC register values and incoming bytes.  The remaining tables
   allow for word-at-a-time CRC calculation for both big-endian and little-
-  endian machines, where a word is four bytes.
+  endian machines, where a word is four bytes.  The slice tables are the CRC
+  of each value followed by zero to fifteen zeros, for calculating the CRC of
+  sixteen bytes at a time on little-endian machines.
 */
 local void make_crc_table()
 {
@@ -125,6 +134,16 @@ local void make_crc_table()
                 crc_table[k + 4][n] = ZSWAP32(c);
             }
         }
+
+        /* generate crc for each value followed by zero to fifteen zeros */
+        for (n = 0; n < 256; n++) {
+            c = crc_table[0][n];
+            crc_slice_table[0][n] = c;
+            for (k = 1; k < SLICES; k++) {
+                c = crc_table[0][c & 0xff] ^ (c >> 8);
+                crc_slice_table[k][n] = c;
+            }
+        }
 #endif /* BYFOUR */
 
         crc_table_empty = 0;
@@ -156,6 +175,17 @@ local void make_crc_table()
         fprintf(out, "#endif\n");
 #  endif /* BYFOUR */
         fprintf(out, "  }\n};\n");
+#  ifdef BYFOUR
+        fprintf(out, "\n#ifdef BYFOUR\n");
+        fprintf(out, "local const z_crc_t FAR ");
+        fprintf(out, "crc_slice_table[SLICES][256] =\n{\n  {\n");
+        write_table(out, crc_slice_table[0]);
+        for (k = 1; k < SLICES; k++) {
+            fprintf(out, "  },\n  {\n");
+            write_table(out, crc_slice_table[k]);
+        }
+        fprintf(out, "  }\n};\n#endif\n");
+#  endif /* BYFOUR */
         fclose(out);
     }
 #endif /* MAKECRCH */
@@ -211,6 +241,24 @@ unsigned long ZEXPORT crc32_z(crc, buf, len)
         make_crc_table();
 #endif /* DYNAMIC_CRC_TABLE */
 
+#ifdef CRC32_SIMD_PCLMUL
+    /* fold the multiples of 16 bytes with carry-less multiplication, if the
+       cpu has it; the tables do the rest */
+    if (len >= CRC32_PCLMUL_MINIMUM_LENGTH) {
+        cpu_check_features();
+        if (x86_cpu_has_pclmulqdq && x86_cpu_has_sse2) {
+            z_size_t chunk = len & ~(z_size_t)CRC32_PCLMUL_CHUNKSIZE_MASK;
+
+            crc = ~crc32_pclmul_simd(~(z_crc_t)crc, Z_NULL, buf, chunk) &
+                  0xffffffffUL;
+            buf += chunk;
+            len -= chunk;
+            if (len == 0)
+                return crc;
+        }
+    }
+#endif /* CRC32_SIMD_PCLMUL */
+
 #ifdef BYFOUR
     if (sizeof(void *) == sizeof(ptrdiff_t)) {
         z_crc_t endian;
@@ -222,6 +270,54 @@ unsigned long ZEXPORT crc32_z(crc, buf, len)
             return crc32_big(crc, buf, len);
     }
 #endif /* BYFOUR */
+    return crc32_bytewise(crc, buf, len);
+}
+
+/* ========================================================================= */
+/* Copy len bytes from src to dst and update crc with them. The bytes are
+   checksummed by the PCLMULQDQ code while they are copied, or else copied and
+   then checksummed in blocks small enough to still be in the level 1 cache. */
+#define CRC32_COPY_BLOCK 4096
+
+unsigned long ZLIB_INTERNAL crc32_copy(crc, dst, src, len)
+    unsigned long crc;
+    unsigned char FAR *dst;
+    const unsigned char FAR *src;
+    z_size_t len;
+{
+    z_size_t n;
+
+#ifdef CRC32_SIMD_PCLMUL
+    if (len >= CRC32_PCLMUL_MINIMUM_LENGTH) {
+        cpu_check_features();
+        if (x86_cpu_has_pclmulqdq && x86_cpu_has_sse2) {
+            n = len & ~(z_size_t)CRC32_PCLMUL_CHUNKSIZE_MASK;
+            crc = ~crc32_pclmul_simd(~(z_crc_t)crc, dst, src, n) &
+                  0xffffffffUL;
+            dst += n;
+            src += n;
+            len -= n;
+        }
+    }
+#endif /* CRC32_SIMD_PCLMUL */
+
+    while (len) {
+        n = len < CRC32_COPY_BLOCK ? len : CRC32_COPY_BLOCK;
+        zmemcpy(dst, src, (uInt)n);
+        crc = crc32_z(crc, dst, n);
+        dst += n;
+        src += n;
+        len -= n;
+    }
+    return crc;
+}
+
+/* ========================================================================= */
+local unsigned long crc32_bytewise(crc, buf, len)
+    unsigned long crc;
+    const unsigned char FAR *buf;
+    z_size_t len;
+{
     crc = crc ^ 0xffffffffUL;
     while (len >= 8) {
         DO8;
@@ -242,6 +338,63 @@ unsigned long ZEXPORT crc32(crc, buf, len)
     return crc32_z(crc, buf, len);
 }
 
+/* ========================================================================= */
+int ZLIB_INTERNAL crc32_variant_available(variant)
+    int variant;
+{
+    switch (variant) {
+    case CRC32_VARIANT_BYTEWISE:
+        return 1;
+#ifdef BYFOUR
+    case CRC32_VARIANT_SLICE16:
+        return sizeof(void *) == sizeof(ptrdiff_t);
+#endif /* BYFOUR */
+#ifdef CRC32_SIMD_PCLMUL
+    case CRC32_VARIANT_PCLMUL:
+        cpu_check_features();
+        return x86_cpu_has_pclmulqdq && x86_cpu_has_sse2;
+#endif /* CRC32_SIMD_PCLMUL */
+    default:
+        return 0;
+    }
+}
+
+/* ========================================================================= */
+unsigned long ZLIB_INTERNAL crc32_variant(variant, crc, buf, len)
+    int variant;
+    unsigned long crc;
+    const unsigned char FAR *buf;
+    z_size_t len;
+{
+    if (buf == Z_NULL || !crc32_variant_available(variant)) return 0UL;
+
+#ifdef DYNAMIC_CRC_TABLE
+    if (crc_table_empty)
+        make_crc_table();
+#endif /* DYNAMIC_CRC_TABLE */
+
+    switch (variant) {
+#ifdef BYFOUR
+    case CRC32_VARIANT_SLICE16:
+    {
+        z_crc_t endian;
+
+        endian = 1;
+        if (*((unsigned char *)(&endian)))
+            return crc32_little(crc, buf, len);
+        else
+            return crc32_big(crc, buf, len);
+    }
+#endif /* BYFOUR */
+#ifdef CRC32_SIMD_PCLMUL
+    case CRC32_VARIANT_PCLMUL:
+        return crc32_z(crc, buf, len);
+#endif /* CRC32_SIMD_PCLMUL */
+    default:
+        return crc32_bytewise(crc, buf, len);
+    }
+}
+
 #ifdef BYFOUR
 
 /*
@@ -260,7 +413,16 @@ unsigned long ZEXPORT crc32(crc, buf, len)
 #define DOLIT4 c ^= *buf4++; \
         c = crc_table[3][c & 0xff] ^ crc_table[2][(c >> 8) & 0xff] ^ \
             crc_table[1][(c >> 16) & 0xff] ^ crc_table[0][c >> 24]
-#define DOLIT32 DOLIT4; DOLIT4; DOLIT4; DOLIT4; DOLIT4; DOLIT4; DOLIT4; DOLIT4
+#define DOLIT16 c ^= buf4[0]; w1 = buf4[1]; w2 = buf4[2]; w3 = buf4[3]; \
+        buf4 += 4; \
+        c = crc_slice_table[15][c & 0xff] ^ crc_slice_table[14][(c >> 8) & 0xff] ^ \
+            crc_slice_table[13][(c >> 16) & 0xff] ^ crc_slice_table[12][c >> 24] ^ \
+            crc_slice_table[11][w1 & 0xff] ^ crc_slice_table[10][(w1 >> 8) & 0xff] ^ \
+            crc_slice_table[9][(w1 >> 16) & 0xff] ^ crc_slice_table[8][w1 >> 24] ^ \
+            crc_slice_table[7][w2 & 0xff] ^ crc_slice_table[6][(w2 >> 8) & 0xff] ^ \
+            crc_slice_table[5][(w2 >> 16) & 0xff] ^ crc_slice_table[4][w2 >> 24] ^ \
+            crc_slice_table[3][w3 & 0xff] ^ crc_slice_table[2][(w3 >> 8) & 0xff] ^ \
+            crc_slice_table[1][(w3 >> 16) & 0xff] ^ crc_slice_table[0][w3 >> 24]
 
 /* ========================================================================= */
 local unsigned long crc32_little(crc, buf, len)
@@ -270,6 +432,7 @@ local unsigned long crc32_little(crc, buf, len)
 {
     register z_crc_t c;
     register const z_crc_t FAR *buf4;
+    z_crc_t w1, w2, w3;
 
     c = (z_crc_t)crc;
     c = ~c;
@@ -278,10 +441,11 @@ local unsigned long crc32_little(crc, buf, len)
         len--;
     }
 
+    /* sixteen bytes at a time (slice-by-16) */
     buf4 = (const z_crc_t FAR *)(const void FAR *)buf;
-    while (len >= 32) {
-        DOLIT32;
-        len -= 32;
+    while (len >= 16) {
+        DOLIT16;
+        len -= 16;
     }
     while (len >= 4) {
         DOLIT4;
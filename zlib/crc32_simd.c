@@ -0,0 +1,141 @@
+/* crc32_simd.c -- CRC-32 with carry-less multiplication
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ *
+ * The data is folded with PCLMULQDQ, four 128-bit lanes at a time, then
+ * folded to 128 and 64 bits and reduced to the 32-bit CRC with a Barrett
+ * reduction, as described in "Fast CRC Computation for Generic Polynomials
+ * Using PCLMULQDQ Instruction" by V. Gopal, E. Ozturk et al., Intel, 2009.
+ * The constants are those of the bit-reflected CRC-32 polynomial 0x104c11db7.
+ */
+
+#include "crc32_simd.h"
+
+#ifdef CRC32_SIMD_PCLMUL
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#ifdef _MSC_VER
+#  define CRC32_ALIGN(n) __declspec(align(n))
+#  define CRC32_TARGET_PCLMUL
+#else
+#  define CRC32_ALIGN(n) __attribute__((aligned(n)))
+#  define CRC32_TARGET_PCLMUL __attribute__((target("sse2,pclmul")))
+#endif
+
+/* ========================================================================= */
+CRC32_TARGET_PCLMUL z_crc_t ZLIB_INTERNAL crc32_pclmul_simd(crc, dst, buf, len)
+    z_crc_t crc;
+    unsigned char FAR *dst;
+    const unsigned char FAR *buf;
+    z_size_t len;
+{
+    /* x^(4*128+32) mod p, x^(4*128-32) mod p: fold by four lanes */
+    static const CRC32_ALIGN(16) unsigned long long k1k2[2] =
+        { 0x0154442bd4ULL, 0x01c6e41596ULL };
+    /* x^(128+32) mod p, x^(128-32) mod p: fold by one lane */
+    static const CRC32_ALIGN(16) unsigned long long k3k4[2] =
+        { 0x01751997d0ULL, 0x00ccaa009eULL };
+    /* x^64 mod p: fold 96 to 64 bits */
+    static const CRC32_ALIGN(16) unsigned long long k5k0[2] =
+        { 0x0163cd6124ULL, 0x0000000000ULL };
+    /* p' (x^64 / p) and p, for the Barrett reduction */
+    static const CRC32_ALIGN(16) unsigned long long poly[2] =
+        { 0x01db710641ULL, 0x01f7011641ULL };
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    x1 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+    x2 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+    x3 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+    x4 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+    if (dst != Z_NULL) {
+        _mm_storeu_si128((__m128i *)(dst + 0x00), x1);
+        _mm_storeu_si128((__m128i *)(dst + 0x10), x2);
+        _mm_storeu_si128((__m128i *)(dst + 0x20), x3);
+        _mm_storeu_si128((__m128i *)(dst + 0x30), x4);
+        dst += 64;
+    }
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    x0 = _mm_load_si128((const __m128i *)k1k2);
+    buf += 64;
+    len -= 64;
+
+    /* fold 64 bytes per step into the four lanes */
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+        y5 = _mm_loadu_si128((const __m128i *)(buf + 0x00));
+        y6 = _mm_loadu_si128((const __m128i *)(buf + 0x10));
+        y7 = _mm_loadu_si128((const __m128i *)(buf + 0x20));
+        y8 = _mm_loadu_si128((const __m128i *)(buf + 0x30));
+        if (dst != Z_NULL) {
+            _mm_storeu_si128((__m128i *)(dst + 0x00), y5);
+            _mm_storeu_si128((__m128i *)(dst + 0x10), y6);
+            _mm_storeu_si128((__m128i *)(dst + 0x20), y7);
+            _mm_storeu_si128((__m128i *)(dst + 0x30), y8);
+            dst += 64;
+        }
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+        buf += 64;
+        len -= 64;
+    }
+
+    /* fold the four lanes into one */
+    x0 = _mm_load_si128((const __m128i *)k3k4);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    /* fold the remaining 16 byte blocks */
+    while (len >= 16) {
+        x2 = _mm_loadu_si128((const __m128i *)buf);
+        if (dst != Z_NULL) {
+            _mm_storeu_si128((__m128i *)dst, x2);
+            dst += 16;
+        }
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+        buf += 16;
+        len -= 16;
+    }
+
+    /* fold 128 to 64 bits */
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+    x0 = _mm_loadl_epi64((const __m128i *)k5k0);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduction to 32 bits */
+    x0 = _mm_load_si128((const __m128i *)poly);
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* the crc is in the second 32-bit word (SSE2 has no pextrd) */
+    return (z_crc_t)(unsigned)_mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+
+#endif /* CRC32_SIMD_PCLMUL */
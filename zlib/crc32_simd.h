@@ -0,0 +1,43 @@
+/* crc32_simd.h -- CRC-32 with carry-less multiplication
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/* WARNING: this file should *not* be used by applications. It is
+   part of the implementation of the compression library and is
+   subject to change. Applications should only use zlib.h.
+ */
+
+#ifndef CRC32_SIMD_H
+#define CRC32_SIMD_H
+
+#include "cpu_features.h"
+
+#if defined(X86_TARGET_ATTRIBUTES) && !defined(NO_CRC32_SIMD)
+#  define CRC32_SIMD_PCLMUL
+#endif
+
+/* crc32_pclmul_simd() folds 64 bytes per step, and needs at least 64 bytes;
+   the length must be a multiple of 16. */
+#define CRC32_PCLMUL_MINIMUM_LENGTH 64
+#define CRC32_PCLMUL_CHUNKSIZE_MASK 15
+
+/* Update the pre- and post-conditioned CRC-32 crc (which is ~crc32) with len
+   bytes of buf, and copy them to dst on the way unless dst is Z_NULL; only
+   call it if x86_cpu_has_pclmulqdq is set. */
+z_crc_t ZLIB_INTERNAL crc32_pclmul_simd OF((z_crc_t crc,
+                                            unsigned char FAR *dst,
+                                            const unsigned char FAR *buf,
+                                            z_size_t len));
+
+/* The implementations of crc32(), for benchmarks and tests. crc32_variant()
+   returns 0 if the variant is not available on this cpu. */
+#define CRC32_VARIANT_BYTEWISE 0    /* one byte at a time */
+#define CRC32_VARIANT_SLICE16  1    /* sixteen bytes at a time with tables */
+#define CRC32_VARIANT_PCLMUL   2    /* PCLMULQDQ, the tables for the rest */
+
+int ZLIB_INTERNAL crc32_variant_available OF((int variant));
+unsigned long ZLIB_INTERNAL crc32_variant OF((int variant, unsigned long crc,
+                                              const unsigned char FAR *buf,
+                                              z_size_t len));
+
+#endif /* CRC32_SIMD_H */
@@ -50,6 +50,7 @@
 /* @(#) $Id$ */
 
 #include "deflate.h"
+#include "deflate_simd.h"
 
 const char deflate_copyright[] =
    " deflate 1.2.11 Copyright 1995-2017 Jean-loup Gailly and Mark Adler ";
@@ -162,6 +163,23 @@ local const config configuration_table[10] = {
  */
 #define UPDATE_HASH(s,h,c) (h = (((h)<<s->hash_shift) ^ (c)) & s->hash_mask)
 
+/* ===========================================================================
+ * Update ins_h for the string at str: with UPDATE_HASH, or with the CRC-32C
+ * of its first four bytes, which does not depend on the previous key.
+ */
+#ifdef DEFLATE_SIMD
+#define UPDATE_HASH_AT(s, str) \
+   ((s)->hash_crc32c ? \
+    ((s)->ins_h = deflate_hash_crc32c((s)->window + (str)) & (s)->hash_mask) : \
+    UPDATE_HASH(s, (s)->ins_h, (s)->window[(str) + (MIN_MATCH-1)]))
+#define LONGEST_MATCH(s, cur_match) \
+   ((s)->simd ? longest_match_simd(s, cur_match) : longest_match(s, cur_match))
+#else
+#define UPDATE_HASH_AT(s, str) \
+    UPDATE_HASH(s, (s)->ins_h, (s)->window[(str) + (MIN_MATCH-1)])
+#define LONGEST_MATCH(s, cur_match) longest_match(s, cur_match)
+#endif
+
 
 /* ===========================================================================
  * Insert string str in the dictionary and set match_head to the previous head
@@ -175,12 +193,12 @@ local const config configuration_table[10] = {
  */
 #ifdef FASTEST
 #define INSERT_STRING(s, str, match_head) \
-   (UPDATE_HASH(s, s->ins_h, s->window[(str) + (MIN_MATCH-1)]), \
+   (UPDATE_HASH_AT(s, str), \
     match_head = s->head[s->ins_h], \
     s->head[s->ins_h] = (Pos)(str))
 #else
 #define INSERT_STRING(s, str, match_head) \
-   (UPDATE_HASH(s, s->ins_h, s->window[(str) + (MIN_MATCH-1)]), \
+   (UPDATE_HASH_AT(s, str), \
     match_head = s->prev[(str) & s->w_mask] = s->head[s->ins_h], \
     s->head[s->ins_h] = (Pos)(str))
 #endif
@@ -205,6 +223,19 @@ local void slide_hash(s)
     Posf *p;
     uInt wsize = s->w_size;
 
+#ifdef DEFLATE_SIMD
+    if (s->simd != DEFLATE_SIMD_NONE) {
+        slide_hash_simd(s->simd, s->head, s->hash_size, wsize);
+        slide_hash_simd(s->simd, s->prev, wsize, wsize);
+        return;
+    }
+#endif
+#ifdef SLIDE_HASH_NEON
+    slide_hash_neon(s->head, s->hash_size, wsize);
+    slide_hash_neon(s->prev, wsize, wsize);
+    return;
+#endif
+
     n = s->hash_size;
     p = &s->head[n];
     do {
@@ -306,6 +337,7 @@ int ZEXPORT deflateInit2_(strm, level, method, windowBits, memLevel, strategy,
     strm->state = (struct internal_state FAR *)s;
     s->strm = strm;
     s->status = INIT_STATE;     /* to pass state test in deflateReset() */
+    s->rawcrc = 0;
 
     s->wrap = wrap;
     s->gzhead = Z_NULL;
@@ -318,7 +350,8 @@ int ZEXPORT deflateInit2_(strm, level, method, windowBits, memLevel, strategy,
     s->hash_mask = s->hash_size - 1;
     s->hash_shift =  ((s->hash_bits+MIN_MATCH-1)/MIN_MATCH);
 
-    s->window = (Bytef *) ZALLOC(strm, s->w_size, 2*sizeof(Byte));
+    s->window = (Bytef *) ZALLOC(strm, 2*s->w_size + DEFLATE_WINDOW_PADDING,
+                                 sizeof(Byte));
     s->prev   = (Posf *)  ZALLOC(strm, s->w_size, sizeof(Pos));
     s->head   = (Posf *)  ZALLOC(strm, s->hash_size, sizeof(Pos));
 
@@ -340,6 +373,15 @@ int ZEXPORT deflateInit2_(strm, level, method, windowBits, memLevel, strategy,
     s->d_buf = overlay + s->lit_bufsize/sizeof(ush);
     s->l_buf = s->pending_buf + (1+sizeof(ush))*s->lit_bufsize;
 
+    /* the padding is only read by the hash, zero it for deterministic output */
+    zmemzero(s->window + 2*s->w_size, DEFLATE_WINDOW_PADDING);
+#ifdef DEFLATE_SIMD
+    s->simd = deflate_simd_select(&s->hash_crc32c);
+#else
+    s->simd = 0;
+    s->hash_crc32c = 0;
+#endif
+
     s->level = level;
     s->strategy = strategy;
     s->method = (Byte)method;
@@ -380,7 +422,7 @@ int ZEXPORT deflateSetDictionary (strm, dictionary, dictLength)
 {
     deflate_state *s;
     uInt str, n;
-    int wrap;
+    int wrap, rawcrc;
     unsigned avail;
     z_const unsigned char *next;
 
@@ -395,6 +437,8 @@ int ZEXPORT deflateSetDictionary (strm, dictionary, dictLength)
     if (wrap == 1)
         strm->adler = adler32(strm->adler, dictionary, dictLength);
     s->wrap = 0;                    /* avoid computing Adler-32 in read_buf */
+    rawcrc = s->rawcrc;
+    s->rawcrc = 0;                  /* the dictionary is not raw input */
 
     /* if dictionary would fill window, just replace the history */
     if (dictLength >= s->w_size) {
@@ -418,7 +462,7 @@ int ZEXPORT deflateSetDictionary (strm, dictionary, dictLength)
         str = s->strstart;
         n = s->lookahead - (MIN_MATCH-1);
         do {
-            UPDATE_HASH(s, s->ins_h, s->window[str + MIN_MATCH-1]);
+            UPDATE_HASH_AT(s, str);
 #ifndef FASTEST
             s->prev[str & s->w_mask] = s->head[s->ins_h];
 #endif
@@ -438,6 +482,7 @@ int ZEXPORT deflateSetDictionary (strm, dictionary, dictLength)
     strm->next_in = next;
     strm->avail_in = avail;
     s->wrap = wrap;
+    s->rawcrc = rawcrc;
     return Z_OK;
 }
 
@@ -493,6 +538,7 @@ int ZEXPORT deflateResetKeep (strm)
 #ifdef GZIP
         s->wrap == 2 ? crc32(0L, Z_NULL, 0) :
 #endif
+        s->wrap == 0 && s->rawcrc ? crc32(0L, Z_NULL, 0) :
         adler32(0L, Z_NULL, 0);
     s->last_flush = Z_NO_FLUSH;
 
@@ -549,13 +595,14 @@ int ZEXPORT deflatePrime (strm, bits, value)
 
     if (deflateStateCheck(strm)) return Z_STREAM_ERROR;
     s = strm->state;
-    if ((Bytef *)(s->d_buf) < s->pending_out + ((Buf_size + 7) >> 3))
+    if (bits < 0 || bits > 16 ||
+        (Bytef *)(s->d_buf) < s->pending_out + ((Buf_size + 7) >> 3))
         return Z_BUF_ERROR;
     do {
         put = Buf_size - s->bi_valid;
         if (put > bits)
             put = bits;
-        s->bi_buf |= (ush)((value & ((1 << put) - 1)) << s->bi_valid);
+        s->bi_buf |= (bi_buf_t)(value & ((1 << put) - 1)) << s->bi_valid;
         s->bi_valid += put;
         _tr_flush_bits(s);
         value >>= put;
@@ -564,6 +611,22 @@ int ZEXPORT deflatePrime (strm, bits, value)
     return Z_OK;
 }
 
+/* ========================================================================= */
+int ZEXPORT deflateRawCrc32 (strm, enable)
+    z_streamp strm;
+    int enable;
+{
+    deflate_state *s;
+
+    if (deflateStateCheck(strm)) return Z_STREAM_ERROR;
+    s = strm->state;
+    if (s->wrap) return Z_STREAM_ERROR;
+    s->rawcrc = enable != 0;
+    if (s->rawcrc)
+        strm->adler = crc32(0L, Z_NULL, 0);
+    return Z_OK;
+}
+
 /* ========================================================================= */
 int ZEXPORT deflateParams(strm, level, strategy)
     z_streamp strm;
@@ -1125,7 +1188,8 @@ int ZEXPORT deflateCopy (dest, source)
     zmemcpy((voidpf)ds, (voidpf)ss, sizeof(deflate_state));
     ds->strm = dest;
 
-    ds->window = (Bytef *) ZALLOC(dest, ds->w_size, 2*sizeof(Byte));
+    ds->window = (Bytef *) ZALLOC(dest, 2*ds->w_size + DEFLATE_WINDOW_PADDING,
+                                  sizeof(Byte));
     ds->prev   = (Posf *)  ZALLOC(dest, ds->w_size, sizeof(Pos));
     ds->head   = (Posf *)  ZALLOC(dest, ds->hash_size, sizeof(Pos));
     overlay = (ushf *) ZALLOC(dest, ds->lit_bufsize, sizeof(ush)+2);
@@ -1137,7 +1201,8 @@ int ZEXPORT deflateCopy (dest, source)
         return Z_MEM_ERROR;
     }
     /* following zmemcpy do not work for 16-bit MSDOS */
-    zmemcpy(ds->window, ss->window, ds->w_size * 2 * sizeof(Byte));
+    zmemcpy(ds->window, ss->window,
+            (2*ds->w_size + DEFLATE_WINDOW_PADDING) * sizeof(Byte));
     zmemcpy((voidpf)ds->prev, (voidpf)ss->prev, ds->w_size * sizeof(Pos));
     zmemcpy((voidpf)ds->head, (voidpf)ss->head, ds->hash_size * sizeof(Pos));
     zmemcpy(ds->pending_buf, ss->pending_buf, (uInt)ds->pending_buf_size);
@@ -1173,15 +1238,20 @@ local unsigned read_buf(strm, buf, size)
 
     strm->avail_in  -= len;
 
-    zmemcpy(buf, strm->next_in, len);
-    if (strm->state->wrap == 1) {
-        strm->adler = adler32(strm->adler, buf, len);
+    /* the CRC-32 is calculated while the input is copied */
+    if (strm->state->wrap == 0 && strm->state->rawcrc) {
+        strm->adler = crc32_copy(strm->adler, buf, strm->next_in, len);
     }
 #ifdef GZIP
     else if (strm->state->wrap == 2) {
-        strm->adler = crc32(strm->adler, buf, len);
+        strm->adler = crc32_copy(strm->adler, buf, strm->next_in, len);
     }
 #endif
+    else {
+        zmemcpy(buf, strm->next_in, len);
+        if (strm->state->wrap == 1)
+            strm->adler = adler32(strm->adler, buf, len);
+    }
     strm->next_in  += len;
     strm->total_in += len;
 
@@ -1543,7 +1613,7 @@ local void fill_window(s)
             Call UPDATE_HASH() MIN_MATCH-3 more times
 #endif
             while (s->insert) {
-                UPDATE_HASH(s, s->ins_h, s->window[str + MIN_MATCH-1]);
+                UPDATE_HASH_AT(s, str);
 #ifndef FASTEST
                 s->prev[str & s->w_mask] = s->head[s->ins_h];
 #endif
@@ -1858,7 +1928,7 @@ local block_state deflate_fast(s, flush)
              * of window index 0 (in particular we have to avoid a match
              * of the string with itself at the start of the input file).
              */
-            s->match_length = longest_match (s, hash_head);
+            s->match_length = LONGEST_MATCH(s, hash_head);
             /* longest_match() sets match_start */
         }
         if (s->match_length >= MIN_MATCH) {
@@ -1964,7 +2034,7 @@ local block_state deflate_slow(s, flush)
              * of window index 0 (in particular we have to avoid a match
              * of the string with itself at the start of the input file).
              */
-            s->match_length = longest_match (s, hash_head);
+            s->match_length = LONGEST_MATCH(s, hash_head);
             /* longest_match() sets match_start */
 
             if (s->match_length <= 5 && (s->strategy == Z_FILTERED
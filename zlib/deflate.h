@@ -48,7 +48,19 @@
 #define MAX_BITS 15
 /* All codes must not exceed MAX_BITS bits */
 
-#define Buf_size 16
+/* The bit buffer has 64 bits where the compiler has a 64-bit type, so that
+ * send_bits() writes eight bytes at a time instead of two. The output is the
+ * same. Define NO_BI_BUF64 for the 16-bit bit buffer.
+ */
+#if !defined(NO_BI_BUF64) && (defined(_MSC_VER) || defined(__GNUC__) || \
+    (defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L))
+#  define BI_BUF64
+   typedef unsigned long long bi_buf_t;
+#  define Buf_size 64
+#else
+   typedef ush bi_buf_t;
+#  define Buf_size 16
+#endif
 /* size of bit buffer in bi_buf */
 
 #define INIT_STATE    42    /* zlib header -> BUSY_STATE */
@@ -105,6 +117,7 @@ typedef struct internal_state {
     Bytef *pending_out;  /* next pending byte to output to the stream */
     ulg   pending;       /* nb of bytes in the pending buffer */
     int   wrap;          /* bit 0 true for zlib, bit 1 true for gzip */
+    int   rawcrc;        /* true for CRC-32 of raw input in strm->adler */
     gz_headerp  gzhead;  /* gzip header information to write */
     ulg   gzindex;       /* where in extra, name, or comment */
     Byte  method;        /* can only be DEFLATED */
@@ -151,6 +164,9 @@ typedef struct internal_state {
      *   hash_shift * MIN_MATCH >= hash_bits
      */
 
+    int   simd;          /* longest_match() implementation (deflate_simd.h) */
+    int   hash_crc32c;   /* true to hash four bytes with CRC-32C instead */
+
     long block_start;
     /* Window position at the beginning of the current output block. Gets
      * negative when the window is moved backwards.
@@ -257,13 +273,13 @@ typedef struct internal_state {
     ulg bits_sent;      /* bit length of compressed data sent mod 2^32 */
 #endif
 
-    ush bi_buf;
+    bi_buf_t bi_buf;
     /* Output buffer. bits are inserted starting at the bottom (least
      * significant bits).
      */
     int bi_valid;
-    /* Number of valid bits in bi_buf.  All bits above the last valid bit
-     * are always zero.
+    /* Number of valid bits in bi_buf, less than Buf_size.  All bits above the
+     * last valid bit are always zero. Outside of trees.c it is less than 8.
      */
 
     ulg high_water;
@@ -0,0 +1,310 @@
+/* deflate_simd.c -- SIMD match finding and hashing for deflate
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ *
+ * longest_match_simd() walks the hash chain like longest_match() in
+ * deflate.c, but compares the candidates 16 (SSE2) or 32 (AVX2) bytes at a
+ * time, and prefetches the next candidate of the chain while the current one
+ * is compared. deflate_hash_crc32c() hashes four bytes with the SSE4.2
+ * CRC-32C instruction, which spreads the strings over the hash table better
+ * than the rolling hash of deflate.c, so the chains hold fewer strings that
+ * do not match. slide_hash_simd() and slide_hash_neon() slide the hash tables
+ * with unsigned saturating subtractions, which clamp the positions that fall
+ * out of the window to NIL.
+ */
+
+#include "deflate_simd.h"
+
+#define NIL 0
+/* Tail of hash chains, as in deflate.c */
+
+#ifdef DEFLATE_SIMD
+
+#include <emmintrin.h>
+#include <immintrin.h>
+#include <nmmintrin.h>
+
+#ifdef _MSC_VER
+#  include <intrin.h>
+#  define DEFLATE_TARGET(t)
+#  define PREFETCH(p) _mm_prefetch((const char *)(p), _MM_HINT_T0)
+#else
+#  define DEFLATE_TARGET(t) __attribute__((target(t)))
+#  define PREFETCH(p) __builtin_prefetch(p)
+#endif
+
+local unsigned first_zero OF((unsigned mask));
+local unsigned compare258_sse2 OF((const Bytef *scan, const Bytef *match));
+local unsigned compare258_avx2 OF((const Bytef *scan, const Bytef *match));
+local void slide_hash_sse2 OF((Posf *table, unsigned entries, uInt wsize));
+local void slide_hash_avx2 OF((Posf *table, unsigned entries, uInt wsize));
+
+/* ========================================================================= */
+/* index of the lowest clear bit of mask, which has one */
+local unsigned first_zero(mask)
+    unsigned mask;
+{
+#ifdef _MSC_VER
+    unsigned long index;
+
+    _BitScanForward(&index, ~mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(~mask);
+#endif
+}
+
+/* ========================================================================= */
+/* Return the number of equal bytes at the start of scan and match, up to
+   MAX_MATCH. Nothing is read past scan + MAX_MATCH and match + MAX_MATCH. */
+DEFLATE_TARGET("sse2")
+local unsigned compare258_sse2(scan, match)
+    const Bytef *scan;
+    const Bytef *match;
+{
+    unsigned len, mask;
+
+    for (len = 0; len < MAX_MATCH - 2; len += 16) {
+        mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_loadu_si128((const __m128i *)(scan + len)),
+            _mm_loadu_si128((const __m128i *)(match + len))));
+        if (mask != 0xffff)
+            return len + first_zero(mask);
+    }
+    if (scan[len] != match[len])
+        return len;
+    return scan[len + 1] != match[len + 1] ? len + 1 : len + 2;
+}
+
+/* ========================================================================= */
+DEFLATE_TARGET("avx2")
+local unsigned compare258_avx2(scan, match)
+    const Bytef *scan;
+    const Bytef *match;
+{
+    unsigned len, mask;
+
+    for (len = 0; len < MAX_MATCH - 2; len += 32) {
+        mask = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_loadu_si256((const __m256i *)(scan + len)),
+            _mm256_loadu_si256((const __m256i *)(match + len))));
+        if (mask != 0xffffffffU)
+            return len + first_zero(mask);
+    }
+    if (scan[len] != match[len])
+        return len;
+    return scan[len + 1] != match[len + 1] ? len + 1 : len + 2;
+}
+
+/* ========================================================================= */
+DEFLATE_TARGET("sse4.2")
+unsigned ZLIB_INTERNAL deflate_hash_crc32c(str)
+    const Bytef *str;
+{
+    unsigned val;
+
+    zmemcpy((Bytef *)&val, str, sizeof(val));
+    return _mm_crc32_u32(0, val);
+}
+
+/* ========================================================================= */
+int ZLIB_INTERNAL deflate_simd_select(hash_crc32c)
+    int *hash_crc32c;
+{
+    int simd = DEFLATE_SIMD_NONE;
+
+    cpu_check_features();
+    if (x86_cpu_has_avx2)
+        simd = DEFLATE_SIMD_AVX2;
+    else if (x86_cpu_has_sse2)
+        simd = DEFLATE_SIMD_SSE2;
+    *hash_crc32c = simd != DEFLATE_SIMD_NONE && x86_cpu_has_sse42;
+    return simd;
+}
+
+/* ========================================================================= */
+/* The same as longest_match() in deflate.c, see there */
+uInt ZLIB_INTERNAL longest_match_simd(s, cur_match)
+    deflate_state *s;
+    IPos cur_match;                             /* current match */
+{
+    unsigned chain_length = s->max_chain_length;/* max hash chain length */
+    Bytef *scan = s->window + s->strstart;      /* current string */
+    Bytef *match;                               /* matched string */
+    int len;                                    /* length of current match */
+    int best_len = (int)s->prev_length;         /* best match length so far */
+    int nice_match = s->nice_match;             /* stop if match long enough */
+    IPos limit = s->strstart > (IPos)MAX_DIST(s) ?
+        s->strstart - (IPos)MAX_DIST(s) : NIL;
+    Posf *prev = s->prev;
+    uInt wmask = s->w_mask;
+    IPos next_match;                            /* next in the chain */
+    Byte scan_end1 = scan[best_len-1];
+    Byte scan_end  = scan[best_len];
+
+    if (s->prev_length >= s->good_match) {
+        chain_length >>= 2;
+    }
+    if ((uInt)nice_match > s->lookahead) nice_match = (int)s->lookahead;
+
+    Assert((ulg)s->strstart <= s->window_size-MIN_LOOKAHEAD, "need lookahead");
+
+    do {
+        Assert(cur_match < s->strstart, "no future");
+        match = s->window + cur_match;
+
+        /* load the next candidate while this one is compared */
+        next_match = prev[cur_match & wmask];
+        PREFETCH(s->window + next_match + best_len - 1);
+
+        /* Reject the candidate on the bytes that end a better match, then
+         * compare the whole match, also the third byte, which two strings
+         * with the same CRC-32C hash need not share.
+         */
+        if (match[best_len]   != scan_end  ||
+            match[best_len-1] != scan_end1 ||
+            match[0]          != scan[0]   ||
+            match[1]          != scan[1])      continue;
+
+        len = (int)(s->simd == DEFLATE_SIMD_AVX2 ? compare258_avx2(scan, match) :
+                                                   compare258_sse2(scan, match));
+
+        if (len > best_len) {
+            s->match_start = cur_match;
+            best_len = len;
+            if (len >= nice_match) break;
+            scan_end1  = scan[best_len-1];
+            scan_end   = scan[best_len];
+        }
+    } while ((cur_match = next_match) > limit && --chain_length != 0);
+
+    if ((uInt)best_len <= s->lookahead) return (uInt)best_len;
+    return s->lookahead;
+}
+
+/* ========================================================================= */
+DEFLATE_TARGET("sse2")
+local void slide_hash_sse2(table, entries, wsize)
+    Posf *table;
+    unsigned entries;
+    uInt wsize;
+{
+    __m128i w = _mm_set1_epi16((short)wsize);
+    __m128i *p = (__m128i *)table;
+
+    do {
+        _mm_storeu_si128(p, _mm_subs_epu16(_mm_loadu_si128(p), w));
+        _mm_storeu_si128(p + 1, _mm_subs_epu16(_mm_loadu_si128(p + 1), w));
+        p += 2;
+    } while (entries -= 16);
+}
+
+/* ========================================================================= */
+DEFLATE_TARGET("avx2")
+local void slide_hash_avx2(table, entries, wsize)
+    Posf *table;
+    unsigned entries;
+    uInt wsize;
+{
+    __m256i w = _mm256_set1_epi16((short)wsize);
+    __m256i *p = (__m256i *)table;
+
+    do {
+        _mm256_storeu_si256(p, _mm256_subs_epu16(_mm256_loadu_si256(p), w));
+        p++;
+    } while (entries -= 16);
+}
+
+/* ========================================================================= */
+void ZLIB_INTERNAL slide_hash_simd(simd, table, entries, wsize)
+    int simd;
+    Posf *table;
+    unsigned entries;
+    uInt wsize;
+{
+    if (simd == DEFLATE_SIMD_AVX2)
+        slide_hash_avx2(table, entries, wsize);
+    else
+        slide_hash_sse2(table, entries, wsize);
+}
+
+#endif /* DEFLATE_SIMD */
+
+#ifdef SLIDE_HASH_NEON
+
+#include <arm_neon.h>
+
+/* ========================================================================= */
+void ZLIB_INTERNAL slide_hash_neon(table, entries, wsize)
+    Posf *table;
+    unsigned entries;
+    uInt wsize;
+{
+    uint16x8_t w = vdupq_n_u16((uint16_t)wsize);
+    uint16_t *p = (uint16_t *)table;
+
+    do {
+        vst1q_u16(p, vqsubq_u16(vld1q_u16(p), w));
+        vst1q_u16(p + 8, vqsubq_u16(vld1q_u16(p + 8), w));
+        p += 16;
+    } while (entries -= 16);
+}
+
+#endif /* SLIDE_HASH_NEON */
+
+/* ========================================================================= */
+int ZLIB_INTERNAL slide_hash_variant_available(variant)
+    int variant;
+{
+    switch (variant) {
+    case SLIDE_HASH_VARIANT_SCALAR:
+        return 1;
+#ifdef DEFLATE_SIMD
+    case SLIDE_HASH_VARIANT_SSE2:
+        cpu_check_features();
+        return x86_cpu_has_sse2;
+    case SLIDE_HASH_VARIANT_AVX2:
+        cpu_check_features();
+        return x86_cpu_has_avx2;
+#endif /* DEFLATE_SIMD */
+#ifdef SLIDE_HASH_NEON
+    case SLIDE_HASH_VARIANT_NEON:
+        return 1;
+#endif /* SLIDE_HASH_NEON */
+    default:
+        return 0;
+    }
+}
+
+/* ========================================================================= */
+void ZLIB_INTERNAL slide_hash_variant(variant, table, entries, wsize)
+    int variant;
+    Posf *table;
+    unsigned entries;
+    uInt wsize;
+{
+    unsigned m;
+
+    if (!slide_hash_variant_available(variant) || entries == 0)
+        return;
+
+    switch (variant) {
+#ifdef DEFLATE_SIMD
+    case SLIDE_HASH_VARIANT_SSE2:
+    case SLIDE_HASH_VARIANT_AVX2:
+        slide_hash_simd(variant, table, entries, wsize);
+        break;
+#endif /* DEFLATE_SIMD */
+#ifdef SLIDE_HASH_NEON
+    case SLIDE_HASH_VARIANT_NEON:
+        slide_hash_neon(table, entries, wsize);
+        break;
+#endif /* SLIDE_HASH_NEON */
+    default:
+        /* the loop of slide_hash() in deflate.c */
+        table += entries;
+        do {
+            m = *--table;
+            *table = (Pos)(m >= wsize ? m - wsize : NIL);
+        } while (--entries);
+    }
+}
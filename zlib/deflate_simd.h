@@ -0,0 +1,67 @@
+/* deflate_simd.h -- SIMD match finding and hashing for deflate
+ * For conditions of distribution and use, see copyright notice in zlib.h
+ */
+
+/* WARNING: this file should *not* be used by applications. It is
+   part of the implementation of the compression library and is
+   subject to change. Applications should only use zlib.h.
+ */
+
+#ifndef DEFLATE_SIMD_H
+#define DEFLATE_SIMD_H
+
+#include "deflate.h"
+#include "cpu_features.h"
+
+/* The assembler match finders and the FASTEST build keep their own code */
+#if defined(X86_TARGET_ATTRIBUTES) && !defined(NO_DEFLATE_SIMD) && \
+    !defined(ASMV) && !defined(FASTEST) && MAX_MATCH == 258
+#  define DEFLATE_SIMD
+#endif
+
+/* All 64-bit ARM cpus have NEON, so it needs no run-time check */
+#if !defined(NO_DEFLATE_SIMD) && (defined(__aarch64__) || defined(_M_ARM64))
+#  define SLIDE_HASH_NEON
+#endif
+
+/* deflate_state.simd: the longest_match() implementation */
+#define DEFLATE_SIMD_NONE 0     /* portable, byte by byte */
+#define DEFLATE_SIMD_SSE2 1     /* 16 bytes at a time */
+#define DEFLATE_SIMD_AVX2 2     /* 32 bytes at a time */
+
+/* The CRC-32C hash reads the four bytes at str (a fourth past MIN_MATCH), so
+   the window is allocated with this many bytes after its end */
+#define DEFLATE_WINDOW_PADDING 8
+
+/* The implementation for this cpu, and whether the cpu has the CRC-32C
+   instruction for the hash. The CRC-32C hash is only used with a SIMD
+   longest_match(), which unlike the portable one compares all bytes of the
+   match, since two strings with the same hash may differ in the third byte. */
+int ZLIB_INTERNAL deflate_simd_select OF((int *hash_crc32c));
+
+/* Hash index of the four bytes at str, with the CRC-32C instruction */
+unsigned ZLIB_INTERNAL deflate_hash_crc32c OF((const Bytef *str));
+
+/* longest_match() with the deflate_state.simd implementation */
+uInt ZLIB_INTERNAL longest_match_simd OF((deflate_state *s, IPos cur_match));
+
+/* Slide the entries of the head or prev table down by wsize, with saturating
+   subtractions; entries must be a multiple of 16, which the table sizes are */
+void ZLIB_INTERNAL slide_hash_simd OF((int simd, Posf *table,
+                                       unsigned entries, uInt wsize));
+void ZLIB_INTERNAL slide_hash_neon OF((Posf *table, unsigned entries,
+                                       uInt wsize));
+
+/* The implementations of slide_hash(), for benchmarks and tests; SSE2 and
+   AVX2 have the values of DEFLATE_SIMD_*. slide_hash_variant() does nothing
+   if the variant is not available. */
+#define SLIDE_HASH_VARIANT_SCALAR 0     /* one entry at a time */
+#define SLIDE_HASH_VARIANT_SSE2   1     /* 8 entries at a time */
+#define SLIDE_HASH_VARIANT_AVX2   2     /* 16 entries at a time */
+#define SLIDE_HASH_VARIANT_NEON   3     /* 8 entries at a time */
+
+int ZLIB_INTERNAL slide_hash_variant_available OF((int variant));
+void ZLIB_INTERNAL slide_hash_variant OF((int variant, Posf *table,
+                                          unsigned entries, uInt wsize));
+
+#endif /* DEFLATE_SIMD_H */
@@ -95,7 +95,7 @@
 local int inflateStateCheck OF((z_streamp strm));
 local void fixedtables OF((struct inflate_state FAR *state));
 local int updatewindow OF((z_streamp strm, const unsigned char FAR *end,
-                           unsigned copy));
+                           unsigned copy, int check));
 #ifdef BUILDFIXED
    void makefixed OF((void));
 #endif
@@ -127,6 +127,8 @@ z_streamp strm;
     strm->msg = Z_NULL;
     if (state->wrap)        /* to support ill-conceived Java test suite */
         strm->adler = state->wrap & 1;
+    else if (state->rawcrc)
+        strm->adler = crc32(0L, Z_NULL, 0);
     state->mode = HEAD;
     state->last = 0;
     state->havedict = 0;
@@ -188,6 +190,8 @@ int windowBits;
 
     /* update state and reset the rest of it */
     state->wrap = wrap;
+    if (wrap)
+        state->rawcrc = 0;
     state->wbits = (unsigned)windowBits;
     return inflateReset(strm);
 }
@@ -227,6 +231,7 @@ int stream_size;
     strm->state = (struct internal_state FAR *)state;
     state->strm = strm;
     state->window = Z_NULL;
+    state->rawcrc = 0;
     state->mode = HEAD;     /* to pass state test in inflateReset2() */
     ret = inflateReset2(strm, windowBits);
     if (ret != Z_OK) {
@@ -385,7 +390,9 @@ void makefixed()
    when a window is already in use, or when output has been written during this
    inflate call, but the end of the deflate stream has not been reached yet.
    It is also called to create a window for dictionary data when a dictionary
-   is loaded.
+   is loaded.  If check is true, the CRC-32 of all copy bytes before end is
+   added to strm->adler; the bytes that go into the window are checksummed
+   while they are copied, when they are still in the cache.
 
    Providing output buffers larger than 32K to inflate() should provide a speed
    advantage, since only the last 32K of output is copied to the sliding window
@@ -393,10 +400,11 @@ void makefixed()
    output will fall in the output data, making match copies simpler and faster.
    The advantage may be dependent on the size of the processor's data caches.
  */
-local int updatewindow(strm, end, copy)
+local int updatewindow(strm, end, copy, check)
 z_streamp strm;
 const Bytef *end;
 unsigned copy;
+int check;
 {
     struct inflate_state FAR *state;
     unsigned dist;
@@ -420,17 +428,32 @@ unsigned copy;
 
     /* copy state->wsize or less output bytes into the circular window */
     if (copy >= state->wsize) {
-        zmemcpy(state->window, end - state->wsize, state->wsize);
+        if (check) {
+            strm->adler = crc32_z(strm->adler, end - copy,
+                                  copy - state->wsize);
+            strm->adler = crc32_copy(strm->adler, state->window,
+                                     end - state->wsize, state->wsize);
+        }
+        else
+            zmemcpy(state->window, end - state->wsize, state->wsize);
         state->wnext = 0;
         state->whave = state->wsize;
     }
     else {
         dist = state->wsize - state->wnext;
         if (dist > copy) dist = copy;
-        zmemcpy(state->window + state->wnext, end - copy, dist);
+        if (check)
+            strm->adler = crc32_copy(strm->adler, state->window + state->wnext,
+                                     end - copy, dist);
+        else
+            zmemcpy(state->window + state->wnext, end - copy, dist);
         copy -= dist;
         if (copy) {
-            zmemcpy(state->window, end - copy, copy);
+            if (check)
+                strm->adler = crc32_copy(strm->adler, state->window,
+                                         end - copy, copy);
+            else
+                zmemcpy(state->window, end - copy, copy);
             state->wnext = copy;
             state->whave = state->wsize;
         }
@@ -636,6 +659,7 @@ int flush;
     code last;                  /* parent table entry */
     unsigned len;               /* length to copy for repeats, bits to drop */
     int ret;                    /* return code */
+    int copied;                 /* true if the window was updated */
 #ifdef GUNZIP
     unsigned char hbuf[4];      /* buffer for gzip header crc calculation */
 #endif
@@ -1252,12 +1276,16 @@ int flush;
      */
   inf_leave:
     RESTORE();
+    copied = 0;
     if (state->wsize || (out != strm->avail_out && state->mode < BAD &&
-            (state->mode < CHECK || flush != Z_FINISH)))
-        if (updatewindow(strm, strm->next_out, out - strm->avail_out)) {
+            (state->mode < CHECK || flush != Z_FINISH))) {
+        if (updatewindow(strm, strm->next_out, out - strm->avail_out,
+                         state->rawcrc)) {
             state->mode = MEM;
             return Z_MEM_ERROR;
         }
+        copied = 1;
+    }
     in -= strm->avail_in;
     out -= strm->avail_out;
     strm->total_in += in;
@@ -1266,6 +1294,8 @@ int flush;
     if ((state->wrap & 4) && out)
         strm->adler = state->check =
             UPDATE(state->check, strm->next_out - out, out);
+    else if (state->rawcrc && !copied && out)
+        strm->adler = crc32_z(strm->adler, strm->next_out - out, out);
     strm->data_type = (int)state->bits + (state->last ? 64 : 0) +
                       (state->mode == TYPE ? 128 : 0) +
                       (state->mode == LEN_ || state->mode == COPY_ ? 256 : 0);
@@ -1336,7 +1366,7 @@ uInt dictLength;
 
     /* copy dictionary to window using updatewindow(), which will amend the
        existing dictionary if appropriate */
-    ret = updatewindow(strm, dictionary + dictLength, dictLength);
+    ret = updatewindow(strm, dictionary + dictLength, dictLength, 0);
     if (ret) {
         state->mode = MEM;
         return Z_MEM_ERROR;
@@ -1523,6 +1553,21 @@ int subvert;
 #endif
 }
 
+int ZEXPORT inflateRawCrc32(strm, enable)
+z_streamp strm;
+int enable;
+{
+    struct inflate_state FAR *state;
+
+    if (inflateStateCheck(strm)) return Z_STREAM_ERROR;
+    state = (struct inflate_state FAR *)strm->state;
+    if (state->wrap || state->mode != HEAD) return Z_STREAM_ERROR;
+    state->rawcrc = enable != 0;
+    if (state->rawcrc)
+        strm->adler = crc32(0L, Z_NULL, 0);
+    return Z_OK;
+}
+
 int ZEXPORT inflateValidate(strm, check)
 z_streamp strm;
 int check;
@@ -176,6 +176,29 @@ local void gen_trees_header OF((void));
     put_byte(s, (uch)((ush)(w) >> 8)); \
 }
 
+/* ===========================================================================
+ * Output the full bit buffer LSB first, with a single store on little-endian
+ * machines.
+ * IN assertion: there is enough room in pendingBuf.
+ */
+#ifndef BI_BUF64
+#  define put_bi_buf(s, w) put_short(s, w)
+#elif defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM) || \
+      defined(_M_ARM64) || (defined(__BYTE_ORDER__) && \
+                            __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#  define put_bi_buf(s, w) { \
+    zmemcpy(s->pending_buf + s->pending, (Bytef *)&(w), 8); \
+    s->pending += 8; \
+}
+#else
+#  define put_bi_buf(s, w) { \
+    put_short(s, w); \
+    put_short(s, (w) >> 16); \
+    put_short(s, (w) >> 32); \
+    put_short(s, (w) >> 48); \
+}
+#endif
+
 /* ===========================================================================
  * Send a value on a given number of bits.
  * IN assertion: length <= 16 and value fits in length bits.
@@ -193,16 +216,17 @@ local void send_bits(s, value, length)
     s->bits_sent += (ulg)length;
 
     /* If not enough room in bi_buf, use (valid) bits from bi_buf and
-     * (16 - bi_valid) bits from value, leaving (width - (16-bi_valid))
-     * unused bits in value.
+     * (Buf_size - bi_valid) bits from value, leaving
+     * (width - (Buf_size-bi_valid)) unused bits in value. A full bi_buf is
+     * written at once, so bi_valid stays less than Buf_size.
      */
-    if (s->bi_valid > (int)Buf_size - length) {
-        s->bi_buf |= (ush)value << s->bi_valid;
-        put_short(s, s->bi_buf);
-        s->bi_buf = (ush)value >> (Buf_size - s->bi_valid);
+    if (s->bi_valid >= (int)Buf_size - length) {
+        s->bi_buf |= (bi_buf_t)value << s->bi_valid;
+        put_bi_buf(s, s->bi_buf);
+        s->bi_buf = (bi_buf_t)value >> (Buf_size - s->bi_valid);
         s->bi_valid += length - Buf_size;
     } else {
-        s->bi_buf |= (ush)value << s->bi_valid;
+        s->bi_buf |= (bi_buf_t)value << s->bi_valid;
         s->bi_valid += length;
     }
 }
@@ -210,14 +234,14 @@ local void send_bits(s, value, length)
 
 #define send_bits(s, value, length) \
 { int len = length;\
-  if (s->bi_valid > (int)Buf_size - len) {\
+  if (s->bi_valid >= (int)Buf_size - len) {\
     int val = (int)value;\
-    s->bi_buf |= (ush)val << s->bi_valid;\
-    put_short(s, s->bi_buf);\
-    s->bi_buf = (ush)val >> (Buf_size - s->bi_valid);\
+    s->bi_buf |= (bi_buf_t)val << s->bi_valid;\
+    put_bi_buf(s, s->bi_buf);\
+    s->bi_buf = (bi_buf_t)val >> (Buf_size - s->bi_valid);\
     s->bi_valid += len - Buf_size;\
   } else {\
-    s->bi_buf |= (ush)(value) << s->bi_valid;\
+    s->bi_buf |= (bi_buf_t)(value) << s->bi_valid;\
     s->bi_valid += len;\
   }\
 }
@@ -1173,11 +1197,7 @@ local unsigned bi_reverse(code, len)
 local void bi_flush(s)
     deflate_state *s;
 {
-    if (s->bi_valid == 16) {
-        put_short(s, s->bi_buf);
-        s->bi_buf = 0;
-        s->bi_valid = 0;
-    } else if (s->bi_valid >= 8) {
+    while (s->bi_valid >= 8) {
         put_byte(s, (Byte)s->bi_buf);
         s->bi_buf >>= 8;
         s->bi_valid -= 8;
@@ -1190,10 +1210,10 @@ local void bi_flush(s)
 local void bi_windup(s)
     deflate_state *s;
 {
-    if (s->bi_valid > 8) {
-        put_short(s, s->bi_buf);
-    } else if (s->bi_valid > 0) {
+    while (s->bi_valid > 0) {
         put_byte(s, (Byte)s->bi_buf);
+        s->bi_buf >>= 8;
+        s->bi_valid -= 8;
     }
     s->bi_buf = 0;
     s->bi_valid = 0;
@@ -1893,6 +1893,10 @@ ZEXTERN int            ZEXPORT inflateValidate OF((z_streamp, int));
 ZEXTERN unsigned long  ZEXPORT inflateCodesUsed OF ((z_streamp));
 ZEXTERN int            ZEXPORT inflateResetKeep OF((z_streamp));
 ZEXTERN int            ZEXPORT deflateResetKeep OF((z_streamp));
+/* for raw deflate and inflate streams only, before any data: keep the CRC-32
+   of the uncompressed data in strm->adler, computed while it is copied */
+ZEXTERN int            ZEXPORT deflateRawCrc32 OF((z_streamp, int));
+ZEXTERN int            ZEXPORT inflateRawCrc32 OF((z_streamp, int));
 #if (defined(_WIN32) || defined(__CYGWIN__)) && !defined(Z_SOLO)
 ZEXTERN gzFile         ZEXPORT gzopen_w OF((const wchar_t *path,
                                             const char *mode));
@@ -233,6 +233,12 @@ extern z_const char * const z_errmsg[10]; /* indexed by 2-zlib_error */
    void ZLIB_INTERNAL zmemzero OF((Bytef* dest, uInt len));
 #endif
 
+/* copy and CRC-32 in one pass, for deflate and inflate (in crc32.c) */
+unsigned long ZLIB_INTERNAL crc32_copy OF((unsigned long crc,
+                                           unsigned char FAR *dst,
+                                           const unsigned char FAR *src,
+                                           z_size_t len));
+
 /* Diagnostic functions */
 #ifdef ZLIB_DEBUG
 #  include <stdio.h>